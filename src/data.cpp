@@ -82,7 +82,10 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
   totalLength += getMetaInfo().wireEncode(encoder);
 
   // Name
-  totalLength += getName().wireEncode(encoder);
+  if (getName().hasWire())
+    totalLength += encoder.prependBlock(getName().wireEncode());
+  else
+    totalLength += getName().wireEncode(encoder);
 
   if (!unsignedPortion)
     {
@@ -111,10 +114,28 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
   encoder.prependVarNumber(totalLength);
   encoder.prependVarNumber(tlv::Data);
 
-  const_cast<Data*>(this)->wireDecode(encoder.block());
+  // Name, MetaInfo, and SignatureInfo are already in place; only the top-level elements are
+  // parsed, so that Content and SignatureValue share the buffer of the wire encoding
+  m_wire = encoder.block();
+  m_wire.parse();
+  m_fullName.clear();
+
+  m_content = m_wire.get(tlv::Content);
+  const_cast<Data*>(this)->m_signature.setValue(m_wire.get(tlv::SignatureValue));
   return m_wire;
 }
 
+size_t
+Data::estimateSigningBufferSize(size_t maxSignatureValueSize) const
+{
+  EncodingEstimator estimator;
+  size_t unsignedPortionSize = wireEncode(estimator, true);
+
+  // Data TLV-TYPE and the largest TLV-LENGTH
+  const size_t maxHeaderSize = 1 + 9;
+  return maxHeaderSize + unsignedPortionSize + maxSignatureValueSize;
+}
+
 const Block&
 Data::wireEncode() const
 {
@@ -183,8 +204,12 @@ Data::getFullName() const
       BOOST_THROW_EXCEPTION(Error("Full name requested, but Data packet does not have wire format "
                                   "(e.g., not signed)"));
     }
+    ConstBufferPtr digest = crypto::computeSha256Digest(m_wire.wire(), m_wire.size());
+    if (digest == nullptr) {
+      BOOST_THROW_EXCEPTION(Error("Cannot compute the implicit digest of Data packet"));
+    }
     m_fullName = m_name;
-    m_fullName.appendImplicitSha256Digest(crypto::computeSha256Digest(m_wire.wire(), m_wire.size()));
+    m_fullName.appendImplicitSha256Digest(digest);
   }
 
   return m_fullName;
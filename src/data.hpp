@@ -123,10 +123,27 @@ public:
    *     ...
    *     Block signatureValue = <sign_over_unsigned_portion>(encoder.buf(), encoder.size());
    *     data.wireEncode(encoder, signatureValue)
+   *
+   * @pre @p encoder contains the unsigned portion of this Data packet, i.e., the Data packet
+   *      has not been changed since it was encoded into @p encoder
    */
   const Block&
   wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const;
 
+  /**
+   * @brief Estimate the size of an EncodingBuffer that can hold the whole packet
+   *        without reallocation
+   *
+   * @param maxSignatureValueSize maximum size of the SignatureValue TLV to be appended
+   *
+   * The EncodingBuffer should reserve @p maxSignatureValueSize from the back:
+   *
+   *     EncodingBuffer encoder(data.estimateSigningBufferSize(maxSize), maxSize);
+   *     data.wireEncode(encoder, true);
+   */
+  size_t
+  estimateSigningBufferSize(size_t maxSignatureValueSize) const;
+
   /**
    * @brief Decode from the wire format
    */
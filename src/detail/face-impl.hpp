@@ -26,7 +26,8 @@
 #include "../face.hpp"
 
 #include "registered-prefix.hpp"
-#include "pending-interest.hpp"
+#include "interest-filter-table.hpp"
+#include "pending-interest-table.hpp"
 #include "container-with-on-empty-signal.hpp"
 
 #include "../util/scheduler.hpp"
@@ -51,8 +52,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord>> InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   explicit
@@ -116,34 +115,27 @@ public: // consumer
     m_pendingInterestTable.clear();
   }
 
+  bool
+  hasPendingInterestsFor(const Name& dataName) const
+  {
+    return m_pendingInterestTable.hasCandidates(dataName);
+  }
+
   void
   satisfyPendingInterests(const Data& data)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest()->matchesData(data)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
-        entry = m_pendingInterestTable.erase(entry);
-        matchedEntry->invokeDataCallback(data);
-      }
-      else {
-        ++entry;
-      }
+    // extract one entry at a time, so that a callback observes the entries removed before it
+    // and the remaining entries observe any change the callback makes to the table
+    while (shared_ptr<PendingInterest> matchedEntry = m_pendingInterestTable.extractFirstMatch(data)) {
+      matchedEntry->invokeDataCallback(data);
     }
   }
 
   void
   nackPendingInterests(const lp::Nack& nack)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      const Interest& pendingInterest = *(*entry)->getInterest();
-      if (nack.getInterest().matchesInterest(pendingInterest)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
-        entry = m_pendingInterestTable.erase(entry);
-        matchedEntry->invokeNackCallback(nack);
-      }
-      else {
-        ++entry;
-      }
+    while (shared_ptr<PendingInterest> matchedEntry = m_pendingInterestTable.extractFirstMatch(nack)) {
+      matchedEntry->invokeNackCallback(nack);
     }
   }
 
@@ -151,27 +143,20 @@ public: // producer
   void
   asyncSetInterestFilter(shared_ptr<InterestFilterRecord> interestFilterRecord)
   {
-    m_interestFilterTable.push_back(interestFilterRecord);
+    m_interestFilterTable.insert(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end()) {
-      m_interestFilterTable.erase(i);
-    }
+    m_interestFilterTable.erase(interestFilterId);
   }
 
   void
   processInterestFilters(Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatches(interest.getName())) {
+      filter->invokeInterestCallback(interest);
     }
   }
 
@@ -214,7 +199,7 @@ public: // prefix registration
 
     if (registeredPrefix->getFilter() != nullptr) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (onSuccess != nullptr) {
@@ -236,7 +221,7 @@ public: // prefix registration
 
       if (filter != nullptr) {
         // it was a combined operation
-        m_interestFilterTable.remove(filter);
+        m_interestFilterTable.erase(filter);
       }
 
       nfd::ControlParameters params;
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "interest-filter-record.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief A table of Interest filters organized as a trie of name components
+ *
+ * Each filter is attached to the trie node of its prefix.  Filters without a regular
+ * expression are matched by walking the Interest name down the trie once; filters with a
+ * regular expression are kept in a separate bucket of the same node, and their regular
+ * expression is evaluated only when the Interest name is under that prefix.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  typedef shared_ptr<InterestFilterRecord> value_type;
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  void
+  insert(const value_type& record)
+  {
+    if (!m_records.emplace(record.get(), record).second) {
+      return;
+    }
+
+    const InterestFilter& filter = record->getFilter();
+    Node* node = &m_root;
+    for (const auto& component : filter.getPrefix()) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+
+    auto& bucket = filter.hasRegexFilter() ? node->regexFilters : node->prefixFilters;
+    bucket.push_back(Entry{m_nextSeqNo++, record});
+  }
+
+  /**
+   * @brief Remove the filter identified by @p interestFilterId
+   * @return whether the filter was found
+   */
+  bool
+  erase(const InterestFilterId* interestFilterId)
+  {
+    auto it = m_records.find(reinterpret_cast<const InterestFilterRecord*>(interestFilterId));
+    if (it == m_records.end()) {
+      return false;
+    }
+    this->erase(it->second);
+    return true;
+  }
+
+  void
+  erase(const value_type& record)
+  {
+    // @p record may refer to the value in m_records, so the trie is pruned before it is erased
+    auto it = m_records.find(record.get());
+    if (it != m_records.end()) {
+      eraseFromNode(m_root, record, 0);
+      m_records.erase(it);
+    }
+  }
+
+  void
+  clear()
+  {
+    m_root.children.clear();
+    m_root.prefixFilters.clear();
+    m_root.regexFilters.clear();
+    m_records.clear();
+  }
+
+  /**
+   * @return filters that match @p name, in the order they were inserted
+   */
+  std::vector<value_type>
+  findMatches(const Name& name) const
+  {
+    std::vector<const Entry*> found;
+    auto collect = [&] (const Node& node) {
+      for (const Entry& entry : node.prefixFilters) {
+        found.push_back(&entry);
+      }
+      for (const Entry& entry : node.regexFilters) {
+        if (entry.record->doesMatch(name)) {
+          found.push_back(&entry);
+        }
+      }
+    };
+
+    const Node* node = &m_root;
+    collect(*node);
+    for (const auto& component : name) {
+      auto child = node->children.find(component);
+      if (child == node->children.end()) {
+        break;
+      }
+      node = child->second.get();
+      collect(*node);
+    }
+
+    std::sort(found.begin(), found.end(),
+              [] (const Entry* a, const Entry* b) { return a->seqNo < b->seqNo; });
+
+    std::vector<value_type> matches;
+    matches.reserve(found.size());
+    for (const Entry* entry : found) {
+      matches.push_back(entry->record);
+    }
+    return matches;
+  }
+
+private:
+  struct Entry
+  {
+    uint64_t seqNo;
+    value_type record;
+  };
+
+  struct Node
+  {
+    bool
+    isEmpty() const
+    {
+      return children.empty() && prefixFilters.empty() && regexFilters.empty();
+    }
+
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<Entry> prefixFilters;
+    std::vector<Entry> regexFilters;
+  };
+
+  /**
+   * @brief Remove @p record from the subtree of @p node at @p depth, pruning empty nodes
+   */
+  static void
+  eraseFromNode(Node& node, const value_type& record, size_t depth)
+  {
+    const InterestFilter& filter = record->getFilter();
+    if (depth == filter.getPrefix().size()) {
+      auto& bucket = filter.hasRegexFilter() ? node.regexFilters : node.prefixFilters;
+      bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                  [&record] (const Entry& entry) { return entry.record == record; }),
+                   bucket.end());
+      return;
+    }
+
+    auto child = node.children.find(filter.getPrefix().get(depth));
+    if (child == node.children.end()) {
+      return;
+    }
+    eraseFromNode(*child->second, record, depth + 1);
+    if (child->second->isEmpty()) {
+      node.children.erase(child);
+    }
+  }
+
+private:
+  Node m_root;
+  std::unordered_map<const InterestFilterRecord*, value_type> m_records;
+  uint64_t m_nextSeqNo = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
@@ -0,0 +1,261 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "../common.hpp"
+#include "../util/signal.hpp"
+#include "pending-interest.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief A table of pending Interests indexed by Interest name
+ *
+ * Entries are kept in insertion order.  In addition, every entry is indexed by its lookup
+ * key, which is the Interest name with a trailing implicit digest component (if any) stripped.
+ * A Data packet can only satisfy an Interest whose lookup key is a prefix of the Data name,
+ * therefore matching a Data or Nack against the table costs a number of hash lookups that
+ * depends on the name length rather than on the number of pending Interests.
+ *
+ * The table emits onEmpty signal when it becomes empty.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  typedef std::list<shared_ptr<PendingInterest>> Base;
+  typedef Base::value_type value_type;
+  typedef Base::iterator iterator;
+
+  iterator
+  begin()
+  {
+    return m_entries.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_entries.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_entries.empty();
+  }
+
+  std::pair<iterator, bool>
+  insert(const value_type& value)
+  {
+    iterator entry = m_entries.insert(m_entries.end(), value);
+    const Name& key = getLookupKey(*value->getInterest());
+    m_index.emplace(key, IndexValue{m_nextSeqNo++, entry});
+    ++m_nKeysByLength[key.size()];
+    return {entry, true};
+  }
+
+  iterator
+  erase(iterator entry)
+  {
+    this->unindex(entry);
+    iterator next = m_entries.erase(entry);
+    if (empty()) {
+      this->onEmpty();
+    }
+    return next;
+  }
+
+  void
+  clear()
+  {
+    m_index.clear();
+    m_nKeysByLength.clear();
+    m_entries.clear();
+    this->onEmpty();
+  }
+
+  template<class Predicate>
+  void
+  remove_if(Predicate p)
+  {
+    for (auto entry = m_entries.begin(); entry != m_entries.end(); ) {
+      if (p(*entry)) {
+        this->unindex(entry);
+        entry = m_entries.erase(entry);
+      }
+      else {
+        ++entry;
+      }
+    }
+    if (empty()) {
+      this->onEmpty();
+    }
+  }
+
+  /**
+   * @brief Determine whether a Data named @p dataName could satisfy any entry
+   *
+   * This only examines lookup keys; a Data for which this returns true may still fail
+   * to match any entry because of Selectors.
+   */
+  bool
+  hasCandidates(const Name& dataName) const
+  {
+    for (const auto& lengthCount : m_nKeysByLength) {
+      if (lengthCount.first > dataName.size()) {
+        break;
+      }
+      if (m_index.count(dataName.getPrefix(lengthCount.first)) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Remove the earliest inserted entry that can be satisfied by @p data
+   * @return removed entry, or nullptr if no entry can be satisfied
+   *
+   * Callers that invoke the callback of the removed entry before extracting the next one
+   * observe any change that the callback makes to the table.
+   */
+  value_type
+  extractFirstMatch(const Data& data)
+  {
+    const Name& dataName = data.getName();
+    return this->extractFirst(
+      [&dataName] (size_t keyLength) { return keyLength <= dataName.size(); },
+      [&dataName] (size_t keyLength) { return dataName.getPrefix(keyLength); },
+      [&data] (const Interest& interest) { return interest.matchesData(data); });
+  }
+
+  /**
+   * @brief Remove the earliest inserted entry whose Interest is matched by the Interest in @p nack
+   * @return removed entry, or nullptr if no entry is matched
+   */
+  value_type
+  extractFirstMatch(const lp::Nack& nack)
+  {
+    const Interest& nackedInterest = nack.getInterest();
+    const Name& key = getLookupKey(nackedInterest);
+    return this->extractFirst(
+      [&key] (size_t keyLength) { return keyLength == key.size(); },
+      [&key] (size_t) { return key; },
+      [&nackedInterest] (const Interest& interest) { return nackedInterest.matchesInterest(interest); });
+  }
+
+private:
+  struct IndexValue
+  {
+    uint64_t seqNo;
+    iterator entry;
+  };
+
+  typedef std::unordered_multimap<Name, IndexValue> Index;
+
+  static Name
+  getLookupKey(const Interest& interest)
+  {
+    const Name& name = interest.getName();
+    if (!name.empty() && name.get(-1).isImplicitSha256Digest()) {
+      return name.getPrefix(-1);
+    }
+    return name;
+  }
+
+  void
+  unindex(iterator entry)
+  {
+    const Name& key = getLookupKey(*(*entry)->getInterest());
+    auto range = m_index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.entry == entry) {
+        m_index.erase(it);
+        break;
+      }
+    }
+
+    auto count = m_nKeysByLength.find(key.size());
+    BOOST_ASSERT(count != m_nKeysByLength.end());
+    if (--count->second == 0) {
+      m_nKeysByLength.erase(count);
+    }
+  }
+
+  /**
+   * @param isCandidateLength whether lookup keys of the given length need to be examined
+   * @param makeKey constructs the lookup key of the given length
+   * @param matches whether the Interest of an indexed entry matches
+   */
+  template<class IsCandidateLength, class MakeKey, class Matches>
+  value_type
+  extractFirst(const IsCandidateLength& isCandidateLength, const MakeKey& makeKey,
+               const Matches& matches)
+  {
+    const IndexValue* first = nullptr;
+    for (const auto& lengthCount : m_nKeysByLength) {
+      if (!isCandidateLength(lengthCount.first)) {
+        continue;
+      }
+      auto range = m_index.equal_range(makeKey(lengthCount.first));
+      for (auto it = range.first; it != range.second; ++it) {
+        if ((first == nullptr || it->second.seqNo < first->seqNo) &&
+            matches(*(*it->second.entry)->getInterest())) {
+          first = &it->second;
+        }
+      }
+    }
+
+    if (first == nullptr) {
+      return nullptr;
+    }
+    value_type matched = *first->entry;
+    this->erase(first->entry);
+    return matched;
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  Base m_entries;
+  Index m_index;
+  std::map<size_t, size_t> m_nKeysByLength; ///< number of indexed keys per key length
+  uint64_t m_nextSeqNo = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -34,6 +34,8 @@ operator<<(std::ostream& os, const SignatureTypeValue& signatureType)
       return os << "SignatureSha256WithRsa";
     case SignatureTypeValue::SignatureSha256WithEcdsa:
       return os << "SignatureSha256WithEcdsa";
+    case SignatureTypeValue::SignatureSha256WithMerkleProof:
+      return os << "SignatureSha256WithMerkleProof";
   }
   return os << "Unknown Signature Type";
 }
@@ -96,7 +96,9 @@ enum SignatureTypeValue {
   DigestSha256 = 0,
   SignatureSha256WithRsa = 1,
   // <Unassigned> = 2,
-  SignatureSha256WithEcdsa = 3
+  SignatureSha256WithEcdsa = 3,
+  // experimental: segment of a batch signed with a single signature over a Merkle tree root
+  SignatureSha256WithMerkleProof = 200
 };
 
 std::ostream&
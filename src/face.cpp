@@ -532,12 +532,31 @@ extractLpLocalFields(NetPkt& netPacket, const lp::Packet& lpPacket)
 void
 Face::onReceiveElement(const Block& blockFromDaemon)
 {
-  lp::Packet lpPacket(blockFromDaemon); // bare Interest/Data is a valid lp::Packet,
-                                        // no need to distinguish
+  // fast path: a bare Interest or Data has no NDNLPv2 fields to extract
+  switch (blockFromDaemon.type()) {
+    case tlv::Interest: {
+      auto interest = make_shared<Interest>(blockFromDaemon);
+      m_impl->processInterestFilters(*interest);
+      return;
+    }
+    case tlv::Data: {
+      // a Data that cannot satisfy any pending Interest is dropped after decoding its Name;
+      // otherwise it is decoded completely before any callback sees it
+      blockFromDaemon.parse();
+      if (!m_impl->hasPendingInterestsFor(Name(blockFromDaemon.get(tlv::Name)))) {
+        return;
+      }
+      auto data = make_shared<Data>(blockFromDaemon);
+      m_impl->satisfyPendingInterests(*data);
+      return;
+    }
+  }
+
+  lp::Packet lpPacket(blockFromDaemon);
 
   Buffer::const_iterator begin, end;
   std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
-  Block netPacket(&*begin, std::distance(begin, end));
+  Block netPacket(blockFromDaemon, begin, end); // shares the received buffer
   switch (netPacket.type()) {
     case tlv::Interest: {
       auto interest = make_shared<Interest>(netPacket);
@@ -554,6 +573,11 @@ Face::onReceiveElement(const Block& blockFromDaemon)
       break;
     }
     case tlv::Data: {
+      // same as the fast path: decode beyond the Name only if a pending Interest needs it
+      netPacket.parse();
+      if (!m_impl->hasPendingInterestsFor(Name(netPacket.get(tlv::Name)))) {
+        return;
+      }
       auto data = make_shared<Data>(netPacket);
       extractLpLocalFields(*data, lpPacket);
       m_impl->satisfyPendingInterests(*data);
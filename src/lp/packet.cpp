@@ -93,7 +93,8 @@ Packet::wireDecode(const Block& wire)
 {
   if (wire.type() == ndn::tlv::Interest || wire.type() == ndn::tlv::Data) {
     m_wire = Block(tlv::LpPacket);
-    add<FragmentField>(make_pair(wire.begin(), wire.end()));
+    // the Fragment element refers to the network packet's buffer without copying it
+    m_wire.push_back(Block(FragmentField::TlvType::value, wire));
     return;
   }
 
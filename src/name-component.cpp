@@ -391,10 +391,20 @@ Component::equals(const Component& other) const
           std::equal(value_begin(), value_end(), other.value_begin()));
 }
 
+/** \brief checks whether TLV-TYPE and TLV-LENGTH of a component with wire encoding
+ *         are encoded in as few octets as possible
+ */
+static bool
+hasMinimalHeader(const Component& component)
+{
+  return static_cast<size_t>(component.value_begin() - component.begin()) ==
+         tlv::sizeOfVarNumber(component.type()) + tlv::sizeOfVarNumber(component.value_size());
+}
+
 int
 Component::compare(const Component& other) const
 {
-  if (this->hasWire() && other.hasWire()) {
+  if (this->hasWire() && other.hasWire() && hasMinimalHeader(*this) && hasMinimalHeader(other)) {
     // In the common case where both components have wire encoding,
     // it's more efficient to simply compare the wire encoding.
     // This works because lexical order of TLV encoding happens to be
@@ -32,6 +32,8 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/functional/hash.hpp>
 
+#include <cstring>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Name>));
@@ -43,12 +45,38 @@ static_assert(std::is_base_of<tlv::Error, Name::Error>::value,
 
 const size_t Name::npos = std::numeric_limits<size_t>::max();
 
+/** \brief feeds the NDN-TLV encoding of \p number into \p seed, as boost::hash_range would do
+ */
+static void
+hashVarNumber(size_t& seed, uint64_t number)
+{
+  uint8_t buf[9];
+  size_t nOctets = tlv::sizeOfVarNumber(number);
+
+  if (nOctets == 1) {
+    buf[0] = static_cast<uint8_t>(number);
+  }
+  else {
+    buf[0] = nOctets == 3 ? 253 : (nOctets == 5 ? 254 : 255);
+    for (size_t i = nOctets - 1; i > 0; --i) {
+      buf[i] = static_cast<uint8_t>(number & 0xFF);
+      number >>= 8;
+    }
+  }
+
+  boost::hash_range(seed, buf, buf + nOctets);
+}
+
 Name::Name()
   : m_nameBlock(tlv::Name)
+  , m_hasHash(false)
+  , m_wireState(WireState::UNKNOWN)
 {
 }
 
 Name::Name(const Block& wire)
+  : m_hasHash(false)
+  , m_wireState(WireState::UNKNOWN)
 {
   m_nameBlock = wire;
   m_nameBlock.parse();
@@ -60,6 +88,8 @@ Name::Name(const char* uri)
 }
 
 Name::Name(std::string uri)
+  : m_hasHash(false)
+  , m_wireState(WireState::UNKNOWN)
 {
   boost::algorithm::trim(uri);
   if (uri.empty())
@@ -153,6 +183,7 @@ Name::wireEncode() const
 
   m_nameBlock = buffer.block();
   m_nameBlock.parse();
+  resetCache();
 
   return m_nameBlock;
 }
@@ -165,6 +196,7 @@ Name::wireDecode(const Block& wire)
 
   m_nameBlock = wire;
   m_nameBlock.parse();
+  resetCache();
 }
 
 std::string
@@ -191,21 +223,21 @@ Name::append(const PartialName& name)
 Name&
 Name::appendNumber(uint64_t number)
 {
-  m_nameBlock.push_back(Component::fromNumber(number));
+  pushBackComponent(Component::fromNumber(number));
   return *this;
 }
 
 Name&
 Name::appendNumberWithMarker(uint8_t marker, uint64_t number)
 {
-  m_nameBlock.push_back(Component::fromNumberWithMarker(marker, number));
+  pushBackComponent(Component::fromNumberWithMarker(marker, number));
   return *this;
 }
 
 Name&
 Name::appendVersion(uint64_t version)
 {
-  m_nameBlock.push_back(Component::fromVersion(version));
+  pushBackComponent(Component::fromVersion(version));
   return *this;
 }
 
@@ -219,42 +251,42 @@ Name::appendVersion()
 Name&
 Name::appendSegment(uint64_t segmentNo)
 {
-  m_nameBlock.push_back(Component::fromSegment(segmentNo));
+  pushBackComponent(Component::fromSegment(segmentNo));
   return *this;
 }
 
 Name&
 Name::appendSegmentOffset(uint64_t offset)
 {
-  m_nameBlock.push_back(Component::fromSegmentOffset(offset));
+  pushBackComponent(Component::fromSegmentOffset(offset));
   return *this;
 }
 
 Name&
 Name::appendTimestamp(const time::system_clock::TimePoint& timePoint)
 {
-  m_nameBlock.push_back(Component::fromTimestamp(timePoint));
+  pushBackComponent(Component::fromTimestamp(timePoint));
   return *this;
 }
 
 Name&
 Name::appendSequenceNumber(uint64_t seqNo)
 {
-  m_nameBlock.push_back(Component::fromSequenceNumber(seqNo));
+  pushBackComponent(Component::fromSequenceNumber(seqNo));
   return *this;
 }
 
 Name&
 Name::appendImplicitSha256Digest(const ConstBufferPtr& digest)
 {
-  m_nameBlock.push_back(Component::fromImplicitSha256Digest(digest));
+  pushBackComponent(Component::fromImplicitSha256Digest(digest));
   return *this;
 }
 
 Name&
 Name::appendImplicitSha256Digest(const uint8_t* digest, size_t digestSize)
 {
-  m_nameBlock.push_back(Component::fromImplicitSha256Digest(digest, digestSize));
+  pushBackComponent(Component::fromImplicitSha256Digest(digest, digestSize));
   return *this;
 }
 
@@ -272,7 +304,7 @@ Name::getSubName(ssize_t iStartComponent, size_t nComponents) const
     iEnd = std::min(this->size(), iStart + nComponents);
 
   for (size_t i = iStart; i < iEnd; ++i)
-    result.append(at(i));
+    result.append(get(i));
 
   return result;
 }
@@ -290,12 +322,53 @@ Name::getSuccessor() const
   return getPrefix(-1).append(get(-1).getSuccessor());
 }
 
+/** \brief checks whether the TLV-TYPE and TLV-LENGTH of \p block are encoded in as few octets
+ *         as possible
+ */
+static bool
+hasMinimalHeader(const Block& block)
+{
+  return static_cast<size_t>(block.value_begin() - block.begin()) ==
+         tlv::sizeOfVarNumber(block.type()) + tlv::sizeOfVarNumber(block.value_size());
+}
+
+bool
+Name::hasCanonicalWire() const
+{
+  if (m_wireState != WireState::UNKNOWN)
+    return m_wireState == WireState::CANONICAL;
+
+  if (!m_nameBlock.hasWire())
+    return false; // not cached: the name is encoded when needed without being modified
+
+  bool isCanonical = hasMinimalHeader(m_nameBlock);
+  Buffer::const_iterator next = m_nameBlock.value_begin();
+  for (const Block& component : m_nameBlock.elements()) {
+    if (!isCanonical)
+      break;
+    isCanonical = component.hasWire() && component.begin() == next && hasMinimalHeader(component);
+    next = component.end();
+  }
+  isCanonical = isCanonical && next == m_nameBlock.value_end();
+
+  m_wireState = isCanonical ? WireState::CANONICAL : WireState::NOT_CANONICAL;
+  return isCanonical;
+}
+
 bool
 Name::equals(const Name& name) const
 {
   if (size() != name.size())
     return false;
 
+  // the hash is computed from the canonical encoding, so equal names have equal hashes
+  if (m_hasHash && name.m_hasHash && m_hash != name.m_hash)
+    return false;
+
+  if (!empty() && hasCanonicalWire() && name.hasCanonicalWire())
+    return m_nameBlock.value_size() == name.m_nameBlock.value_size() &&
+           std::memcmp(m_nameBlock.value(), name.m_nameBlock.value(), m_nameBlock.value_size()) == 0;
+
   for (size_t i = 0; i < size(); ++i) {
     if (at(i) != name.at(i))
       return false;
@@ -311,6 +384,11 @@ Name::isPrefixOf(const Name& name) const
   if (size() > name.size())
     return false;
 
+  // This name is encoded at the beginning of the value of the other name if it is a prefix.
+  if (!empty() && hasCanonicalWire() && name.hasCanonicalWire())
+    return m_nameBlock.value_size() <= name.m_nameBlock.value_size() &&
+           std::memcmp(m_nameBlock.value(), name.m_nameBlock.value(), m_nameBlock.value_size()) == 0;
+
   // Check if at least one of given components doesn't match.
   for (size_t i = 0; i < size(); ++i) {
     if (at(i) != name.at(i))
@@ -320,6 +398,39 @@ Name::isPrefixOf(const Name& name) const
   return true;
 }
 
+size_t
+Name::getHash() const
+{
+  if (m_hasHash)
+    return m_hash;
+
+  size_t seed = 0;
+  if (hasCanonicalWire()) {
+    boost::hash_range(seed, m_nameBlock.wire(), m_nameBlock.wire() + m_nameBlock.size());
+  }
+  else {
+    // hash the canonical encoding that wireEncode() would produce for the components,
+    // without allocating it
+    size_t valueSize = 0;
+    for (const Component& component : *this) {
+      valueSize += tlv::sizeOfVarNumber(component.type()) +
+                   tlv::sizeOfVarNumber(component.value_size()) + component.value_size();
+    }
+
+    hashVarNumber(seed, tlv::Name);
+    hashVarNumber(seed, valueSize);
+    for (const Component& component : *this) {
+      hashVarNumber(seed, component.type());
+      hashVarNumber(seed, component.value_size());
+      boost::hash_range(seed, component.value_begin(), component.value_end());
+    }
+  }
+
+  m_hash = seed;
+  m_hasHash = true;
+  return m_hash;
+}
+
 int
 Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t count2) const
 {
@@ -327,6 +438,25 @@ Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t
   count2 = std::min(count2, other.size() - pos2);
   size_t count = std::min(count1, count2);
 
+  if (count > 0 && this->hasCanonicalWire() && other.hasCanonicalWire()) {
+    // Lexical order of the concatenated component TLVs is the same as their canonical order
+    // (see Component::compare), and when the shorter range equals the beginning of the longer
+    // one, it has fewer components; thus the ranges can be compared as a whole.
+    const uint8_t* first1 = this->get(pos1).wire();
+    const Component& last1 = this->get(pos1 + count1 - 1);
+    size_t size1 = last1.wire() + last1.size() - first1;
+
+    const uint8_t* first2 = other.get(pos2).wire();
+    const Component& last2 = other.get(pos2 + count2 - 1);
+    size_t size2 = last2.wire() + last2.size() - first2;
+
+    int comp = std::memcmp(first1, first2, std::min(size1, size2));
+    if (comp != 0) {
+      return comp;
+    }
+    return count1 - count2;
+  }
+
   for (size_t i = 0; i < count; ++i) {
     int comp = this->at(pos1 + i).compare(other.at(pos2 + i));
     if (comp != 0) { // i-th component differs
@@ -370,8 +500,7 @@ namespace std {
 size_t
 hash<ndn::Name>::operator()(const ndn::Name& name) const
 {
-  return boost::hash_range(name.wireEncode().wire(),
-                           name.wireEncode().wire() + name.wireEncode().size());
+  return name.getHash();
 }
 
 } // namespace std
@@ -42,6 +42,11 @@ typedef Name PartialName;
 
 /**
  * @brief Name abstraction to represent an absolute name
+ *
+ * @note A Name is not safe for concurrent use by multiple threads, even through const member
+ *       functions: wireEncode, getHash, equals, compare, and isPrefixOf may update the cached
+ *       wire encoding, hash, and wire state.  A Name shared between threads must be protected
+ *       by the caller, or each thread must use its own copy.
  */
 class Name : public enable_shared_from_this<Name>
 {
@@ -139,7 +144,7 @@ public:
   Name&
   append(const uint8_t* value, size_t valueLength)
   {
-    m_nameBlock.push_back(Component(value, valueLength));
+    pushBackComponent(Component(value, valueLength));
     return *this;
   }
 
@@ -156,7 +161,7 @@ public:
   Name&
   append(Iterator first, Iterator last)
   {
-    m_nameBlock.push_back(Component(first, last));
+    pushBackComponent(Component(first, last));
     return *this;
   }
 
@@ -166,7 +171,7 @@ public:
   Name&
   append(const Component& value)
   {
-    m_nameBlock.push_back(value);
+    pushBackComponent(value);
     return *this;
   }
 
@@ -180,7 +185,7 @@ public:
   Name&
   append(const char* value)
   {
-    m_nameBlock.push_back(Component(value));
+    pushBackComponent(Component(value));
     return *this;
   }
 
@@ -188,9 +193,9 @@ public:
   append(const Block& value)
   {
     if (value.type() == tlv::NameComponent)
-      m_nameBlock.push_back(value);
+      pushBackComponent(value);
     else
-      m_nameBlock.push_back(Block(tlv::NameComponent, value));
+      pushBackComponent(Block(tlv::NameComponent, value));
 
     return *this;
   }
@@ -210,6 +215,7 @@ public:
   clear()
   {
     m_nameBlock = Block(tlv::Name);
+    resetCache();
   }
 
   /**
@@ -477,6 +483,14 @@ public:
   compare(size_t pos1, size_t count1,
           const Name& other, size_t pos2 = 0, size_t count2 = npos) const;
 
+  /** \brief get a hash value of the TLV encoding of this name
+   *
+   *  The value is computed from the components without encoding the name, and is cached
+   *  until the name is modified.  std::hash<Name> returns this value.
+   */
+  size_t
+  getHash() const;
+
   /**
    * Append the component
    * @param component The component of type T.
@@ -605,7 +619,42 @@ public:
   static const size_t npos;
 
 private:
+  /** \brief checks whether the wire encoding is canonical and the components lie contiguously in it
+   *
+   *  Only then does comparing wire encodings byte by byte give the same result as comparing
+   *  the components: decoding accepts a TLV-TYPE or TLV-LENGTH encoded in more octets than
+   *  necessary, with which equal components have different encodings.
+   *  The result is cached until the name is modified.
+   */
+  bool
+  hasCanonicalWire() const;
+
+  void
+  pushBackComponent(const Block& component)
+  {
+    m_nameBlock.push_back(component);
+    resetCache();
+  }
+
+  void
+  resetCache() const
+  {
+    m_hasHash = false;
+    m_wireState = WireState::UNKNOWN;
+  }
+
+private:
+  enum class WireState : uint8_t {
+    UNKNOWN,
+    CANONICAL,
+    NOT_CANONICAL
+  };
+
+  // caches updated by const member functions; see the note in the class description
   mutable Block m_nameBlock;
+  mutable size_t m_hash;
+  mutable bool m_hasHash;
+  mutable WireState m_wireState;
 };
 
 std::ostream&
@@ -70,6 +70,18 @@ public:
     return matchName(unsignedName);
   }
 
+  /**
+   * @brief Get a name that is a prefix of every name matched by this filter
+   *
+   * ValidatorConfig uses it to index rules by name.  An empty name means that the filter
+   * may match any name.
+   */
+  virtual Name
+  getMatchedPrefix() const
+  {
+    return Name();
+  }
+
 protected:
   virtual bool
   matchName(const Name& name) = 0;
@@ -96,6 +108,12 @@ public:
   {
   }
 
+  Name
+  getMatchedPrefix() const override
+  {
+    return m_name;
+  }
+
 protected:
   virtual bool
   matchName(const Name& name)
@@ -124,6 +142,7 @@ public:
   explicit
   RegexNameFilter(const Regex& regex)
     : m_regex(regex)
+    , m_matchedPrefix(extractLiteralPrefix(regex.getExpr()))
   {
   }
 
@@ -132,6 +151,12 @@ public:
   {
   }
 
+  Name
+  getMatchedPrefix() const override
+  {
+    return m_matchedPrefix;
+  }
+
 protected:
   virtual bool
   matchName(const Name& name)
@@ -139,8 +164,47 @@ protected:
     return m_regex.match(name);
   }
 
+private:
+  /**
+   * @brief Get the components that an anchored regex matches literally at its beginning
+   *
+   * For example, `^<ndn><edu><>*` yields `/ndn/edu`.  A component is literal when its
+   * expression consists of characters that have no special meaning in a regular expression
+   * and it is not followed by a repetition.
+   */
+  static Name
+  extractLiteralPrefix(const std::string& expr)
+  {
+    Name prefix;
+    if (expr.empty() || expr[0] != '^')
+      return prefix;
+
+    size_t pos = 1;
+    while (pos < expr.size() && expr[pos] == '<') {
+      size_t end = expr.find('>', pos);
+      if (end == std::string::npos || end == pos + 1)
+        break;
+
+      std::string component = expr.substr(pos + 1, end - pos - 1);
+      bool isLiteral = std::all_of(component.begin(), component.end(), [] (char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '~';
+      });
+      if (!isLiteral)
+        break;
+
+      pos = end + 1;
+      if (pos < expr.size() && (expr[pos] == '*' || expr[pos] == '+' ||
+                                expr[pos] == '?' || expr[pos] == '{'))
+        break;
+
+      prefix.append(component);
+    }
+    return prefix;
+  }
+
 private:
   Regex m_regex;
+  Name m_matchedPrefix;
 };
 
 class FilterFactory
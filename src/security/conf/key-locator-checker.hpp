@@ -30,6 +30,7 @@
 #include "../../util/regex.hpp"
 #include "../security-common.hpp"
 #include <boost/algorithm/string.hpp>
+#include <unordered_map>
 
 #include "common.hpp"
 
@@ -39,6 +40,42 @@ namespace conf {
 
 class KeyLocatorCheckerFactory;
 
+/**
+ * @brief Memoizes a result computed from a key name by a regular expression
+ *
+ * Packets signed by the same key reuse the result without running the regular expression
+ * again.  The memo is cleared when it reaches its capacity, which bounds the memory used when
+ * packets are signed by many different keys.
+ */
+template<typename T>
+class KeyNameMemo
+{
+public:
+  const T*
+  find(const Name& keyName) const
+  {
+    auto it = m_results.find(keyName);
+    return it == m_results.end() ? nullptr : &it->second;
+  }
+
+  const T&
+  insert(const Name& keyName, const T& result)
+  {
+    if (m_results.size() >= CAPACITY)
+      m_results.clear();
+    return m_results.emplace(keyName, result).first->second;
+  }
+
+public:
+  static const size_t CAPACITY = 1024;
+
+private:
+  std::unordered_map<Name, T> m_results;
+};
+
+template<typename T>
+const size_t KeyNameMemo<T>::CAPACITY;
+
 /**
  * @brief KeyLocatorChecker is one of the classes used by ValidatorConfig.
  *
@@ -162,7 +199,12 @@ protected:
   {
     try
       {
-        if (m_regex.match(keyLocator.getName()))
+        const Name& keyName = keyLocator.getName();
+        const bool* isMatched = m_matches.find(keyName);
+        if (isMatched == nullptr)
+          isMatched = &m_matches.insert(keyName, m_regex.match(keyName));
+
+        if (*isMatched)
           return true;
 
         failInfo = "KeyLocatorChecker failed!";
@@ -177,6 +219,7 @@ protected:
 
 private:
   Regex m_regex;
+  KeyNameMemo<bool> m_matches;
 };
 
 class HyperKeyLocatorNameChecker : public KeyLocatorChecker
@@ -199,10 +242,19 @@ protected:
   {
     try
       {
-        if (m_hyperPRegex->match(packetName) &&
-            m_hyperKRegex->match(keyLocator.getName()) &&
+        const Name& keyName = keyLocator.getName();
+        const optional<Name>* kExpansion = m_kExpansions.find(keyName);
+        if (kExpansion == nullptr) {
+          optional<Name> expansion;
+          if (m_hyperKRegex->match(keyName))
+            expansion = m_hyperKRegex->expand();
+          kExpansion = &m_kExpansions.insert(keyName, expansion);
+        }
+
+        if (*kExpansion &&
+            m_hyperPRegex->match(packetName) &&
             checkRelation(m_hyperRelation,
-                          m_hyperKRegex->expand(),
+                          **kExpansion,
                           m_hyperPRegex->expand()))
           return true;
 
@@ -221,6 +273,8 @@ private:
   shared_ptr<Regex> m_hyperPRegex;
   shared_ptr<Regex> m_hyperKRegex;
   Relation m_hyperRelation;
+  /// expansion of k-regex for each key name, or nullopt if k-regex does not match
+  KeyNameMemo<optional<Name>> m_kExpansions;
 };
 
 
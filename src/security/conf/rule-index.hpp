@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_CONF_RULE_INDEX_HPP
+#define NDN_SECURITY_CONF_RULE_INDEX_HPP
+
+#include "rule.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace security {
+namespace conf {
+
+/**
+ * @brief A set of rules organized as a trie of name components
+ *
+ * Each rule is attached to the trie node of the prefix that its filters require
+ * (Rule::getMatchedPrefix).  A packet walks the trie once along its name, so that only rules
+ * under a prefix of the packet name are matched, and their filters are evaluated in the order
+ * the rules have been inserted until the first one matches.
+ */
+template<class Packet>
+class RuleIndex
+{
+public:
+  typedef shared_ptr<Rule<Packet>> RulePtr;
+
+  size_t
+  size() const
+  {
+    return m_nRules;
+  }
+
+  bool
+  empty() const
+  {
+    return m_nRules == 0;
+  }
+
+  /**
+   * @brief Append @p rule, which has lower priority than the rules inserted before it
+   */
+  void
+  insert(const RulePtr& rule)
+  {
+    Node* node = &m_root;
+    for (const auto& component : rule->getMatchedPrefix()) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+    node->rules.push_back(Entry{m_nRules++, rule});
+  }
+
+  void
+  clear()
+  {
+    m_root.children.clear();
+    m_root.rules.clear();
+    m_nRules = 0;
+  }
+
+  /**
+   * @return the first inserted rule that matches @p packet, or nullptr if none matches
+   */
+  RulePtr
+  findFirstMatch(const Packet& packet) const
+  {
+    std::vector<const Entry*> candidates;
+    const Node* node = &m_root;
+    for (const Entry& entry : node->rules) {
+      candidates.push_back(&entry);
+    }
+
+    const Name& name = packet.getName();
+    size_t nComponents = getNMatchedComponents(packet);
+    for (size_t i = 0; i < nComponents; ++i) {
+      auto child = node->children.find(name[i]);
+      if (child == node->children.end()) {
+        break;
+      }
+      node = child->second.get();
+      for (const Entry& entry : node->rules) {
+        candidates.push_back(&entry);
+      }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [] (const Entry* a, const Entry* b) { return a->seqNo < b->seqNo; });
+
+    for (const Entry* entry : candidates) {
+      if (entry->rule->match(packet)) {
+        return entry->rule;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  /**
+   * @return number of leading components of the packet name that filters match against
+   */
+  static size_t
+  getNMatchedComponents(const Data& data)
+  {
+    return data.getName().size();
+  }
+
+  static size_t
+  getNMatchedComponents(const Interest& interest)
+  {
+    // filters match the name of a signed Interest without its signature components
+    size_t nComponents = interest.getName().size();
+    return nComponents < command_interest::MIN_SIZE ? 0 : nComponents - command_interest::MIN_SIZE;
+  }
+
+private:
+  struct Entry
+  {
+    size_t seqNo;
+    RulePtr rule;
+  };
+
+  struct Node
+  {
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<Entry> rules;
+  };
+
+  Node m_root;
+  size_t m_nRules = 0;
+};
+
+} // namespace conf
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_CONF_RULE_INDEX_HPP
@@ -66,6 +66,23 @@ public:
     m_checkers.push_back(checker);
   }
 
+  /**
+   * @brief Get a name that is a prefix of every packet name matched by this rule
+   *
+   * This is the longest of the prefixes of the filters, all of which must match.
+   */
+  Name
+  getMatchedPrefix() const
+  {
+    Name prefix;
+    for (const auto& filter : m_filters) {
+      Name filterPrefix = filter->getMatchedPrefix();
+      if (filterPrefix.size() > prefix.size())
+        prefix = filterPrefix;
+    }
+    return prefix;
+  }
+
   bool
   match(const Packet& packet)
   {
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "merkle-tree.hpp"
+#include "openssl-helper.hpp"
+
+#include <cstring>
+
+namespace ndn {
+namespace security {
+namespace detail {
+
+static const uint8_t LEAF_PREFIX = 0x00;
+static const uint8_t NODE_PREFIX = 0x01;
+
+MerkleTree::MerkleTree(std::vector<Digest> leaves)
+{
+  BOOST_ASSERT(!leaves.empty());
+  m_levels.push_back(std::move(leaves));
+
+  while (m_levels.back().size() > 1) {
+    const std::vector<Digest>& below = m_levels.back();
+    std::vector<Digest> level;
+    level.reserve((below.size() + 1) / 2);
+    for (size_t i = 0; i + 1 < below.size(); i += 2) {
+      level.push_back(hashChildren(below[i], below[i + 1]));
+    }
+    if (below.size() % 2 == 1) {
+      level.push_back(below.back());
+    }
+    m_levels.push_back(std::move(level));
+  }
+}
+
+Buffer
+MerkleTree::getProof(size_t index) const
+{
+  BOOST_ASSERT(index < getLeafCount());
+
+  Buffer proof;
+  for (size_t i = 0; i + 1 < m_levels.size(); ++i, index /= 2) {
+    size_t sibling = index ^ 1;
+    if (sibling < m_levels[i].size()) {
+      proof.insert(proof.end(), m_levels[i][sibling].begin(), m_levels[i][sibling].end());
+    }
+  }
+  return proof;
+}
+
+MerkleTree::Digest
+MerkleTree::hashLeaf(const uint8_t* buf, size_t size)
+{
+  Digest digest;
+  EvpMdCtx ctx;
+  if (!EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr) ||
+      !EVP_DigestUpdate(ctx.get(), &LEAF_PREFIX, 1) ||
+      !EVP_DigestUpdate(ctx.get(), buf, size) ||
+      !EVP_DigestFinal_ex(ctx.get(), digest.data(), nullptr)) {
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to compute SHA-256 digest"));
+  }
+  return digest;
+}
+
+MerkleTree::Digest
+MerkleTree::hashChildren(const Digest& a, const Digest& b)
+{
+  const Digest& first = a < b ? a : b;
+  const Digest& second = a < b ? b : a;
+
+  Digest digest;
+  EvpMdCtx ctx;
+  if (!EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr) ||
+      !EVP_DigestUpdate(ctx.get(), &NODE_PREFIX, 1) ||
+      !EVP_DigestUpdate(ctx.get(), first.data(), first.size()) ||
+      !EVP_DigestUpdate(ctx.get(), second.data(), second.size()) ||
+      !EVP_DigestFinal_ex(ctx.get(), digest.data(), nullptr)) {
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to compute SHA-256 digest"));
+  }
+  return digest;
+}
+
+bool
+MerkleTree::verifyProof(const Digest& leaf, const uint8_t* proof, size_t proofLen,
+                        const uint8_t* root, size_t rootLen)
+{
+  if (proofLen % std::tuple_size<Digest>::value != 0 || rootLen != std::tuple_size<Digest>::value) {
+    return false;
+  }
+
+  Digest node = leaf;
+  Digest sibling;
+  for (size_t offset = 0; offset < proofLen; offset += sibling.size()) {
+    std::memcpy(sibling.data(), proof + offset, sibling.size());
+    node = hashChildren(node, sibling);
+  }
+  return std::memcmp(node.data(), root, rootLen) == 0;
+}
+
+} // namespace detail
+} // namespace security
+} // namespace ndn
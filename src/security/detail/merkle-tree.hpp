@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_CXX_SECURITY_DETAIL_MERKLE_TREE_HPP
+#define NDN_CXX_SECURITY_DETAIL_MERKLE_TREE_HPP
+
+#include "../../common.hpp"
+#include "../../encoding/buffer.hpp"
+#include "../../util/crypto.hpp"
+
+#include <array>
+
+namespace ndn {
+namespace security {
+namespace detail {
+
+/**
+ * @brief SHA-256 Merkle hash tree
+ *
+ * A leaf is SHA-256(0x00 || input).  An inner node is SHA-256(0x01 || min(a, b) || max(a, b))
+ * of its children a and b, so that an inclusion proof consists of the sibling digests only,
+ * without the position of the leaf.  A node without a sibling is promoted to the next level.
+ */
+class MerkleTree : noncopyable
+{
+public:
+  typedef std::array<uint8_t, crypto::SHA256_DIGEST_SIZE> Digest;
+
+  /**
+   * @brief Build the tree over @p leaves
+   * @pre @p leaves is not empty
+   */
+  explicit
+  MerkleTree(std::vector<Digest> leaves);
+
+  const Digest&
+  getRoot() const
+  {
+    return m_levels.back().front();
+  }
+
+  size_t
+  getLeafCount() const
+  {
+    return m_levels.front().size();
+  }
+
+  /**
+   * @return the sibling digests on the path from leaf @p index to the root, concatenated
+   *         from the leaf level upwards
+   */
+  Buffer
+  getProof(size_t index) const;
+
+  static Digest
+  hashLeaf(const uint8_t* buf, size_t size);
+
+  /**
+   * @brief Check that the leaf digest @p leaf and the sibling digests in @p proof hash to @p root
+   */
+  static bool
+  verifyProof(const Digest& leaf, const uint8_t* proof, size_t proofLen,
+              const uint8_t* root, size_t rootLen);
+
+private:
+  static Digest
+  hashChildren(const Digest& a, const Digest& b);
+
+private:
+  std::vector<std::vector<Digest>> m_levels;
+};
+
+} // namespace detail
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_CXX_SECURITY_DETAIL_MERKLE_TREE_HPP
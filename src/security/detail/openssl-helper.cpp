@@ -36,6 +36,25 @@ toDigestEvpMd(DigestAlgorithm algo)
   }
 }
 
+EvpMdCtx::EvpMdCtx()
+#if OPENSSL_VERSION_NUMBER < 0x1010000fL
+  : m_ctx(EVP_MD_CTX_create())
+#else
+  : m_ctx(EVP_MD_CTX_new())
+#endif // OPENSSL_VERSION_NUMBER < 0x1010000fL
+{
+  BOOST_ASSERT(m_ctx != nullptr);
+}
+
+EvpMdCtx::~EvpMdCtx()
+{
+#if OPENSSL_VERSION_NUMBER < 0x1010000fL
+  EVP_MD_CTX_destroy(m_ctx);
+#else
+  EVP_MD_CTX_free(m_ctx);
+#endif // OPENSSL_VERSION_NUMBER < 0x1010000fL
+}
+
 EvpPkey::EvpPkey()
   : m_key(nullptr)
 {
@@ -32,6 +32,23 @@ namespace detail {
 const EVP_MD*
 toDigestEvpMd(DigestAlgorithm algo);
 
+class EvpMdCtx
+{
+public:
+  EvpMdCtx();
+
+  ~EvpMdCtx();
+
+  EVP_MD_CTX*
+  get() const
+  {
+    return m_ctx;
+  }
+
+private:
+  EVP_MD_CTX* m_ctx;
+};
+
 class EvpPkey
 {
 public:
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "worker-pool.hpp"
+
+#include <system_error>
+
+namespace ndn {
+namespace security {
+namespace detail {
+
+WorkerPool::WorkerPool(size_t nWorkers)
+  : m_work(nullptr)
+  , m_nParticipants(0)
+  , m_nRunning(0)
+  , m_generation(0)
+  , m_isStopping(false)
+{
+  m_workers.reserve(nWorkers);
+  try {
+    for (size_t i = 0; i < nWorkers; ++i) {
+      m_workers.emplace_back(&WorkerPool::runWorker, this, i);
+    }
+  }
+  catch (const std::system_error&) {
+    // continue with the threads that could be started
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_hasWork.notify_all();
+
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void
+WorkerPool::run(size_t nWorkers, const std::function<void()>& work)
+{
+  std::lock_guard<std::mutex> runLock(m_runMutex);
+
+  nWorkers = std::min(nWorkers, m_workers.size());
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_work = &work;
+    m_nParticipants = nWorkers;
+    m_nRunning = nWorkers;
+    ++m_generation;
+  }
+  m_hasWork.notify_all();
+
+  work();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_isDone.wait(lock, [this] { return m_nRunning == 0; });
+  m_work = nullptr;
+}
+
+void
+WorkerPool::runWorker(size_t index)
+{
+  uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_hasWork.wait(lock, [&] { return m_isStopping || m_generation != generation; });
+    if (m_isStopping) {
+      return;
+    }
+
+    // a thread that does not take part skips this run
+    generation = m_generation;
+    if (index >= m_nParticipants) {
+      continue;
+    }
+
+    const std::function<void()>& work = *m_work;
+    lock.unlock();
+    work();
+    lock.lock();
+
+    if (--m_nRunning == 0) {
+      m_isDone.notify_one();
+    }
+  }
+}
+
+} // namespace detail
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_DETAIL_WORKER_POOL_HPP
+#define NDN_SECURITY_DETAIL_WORKER_POOL_HPP
+
+#include "../../common.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace detail {
+
+/**
+ * @brief Threads that run a function together with the calling thread
+ *
+ * The threads are started when the pool is created, and wait for work until the pool is
+ * destroyed.
+ */
+class WorkerPool : noncopyable
+{
+public:
+  /**
+   * @brief Start @p nWorkers threads, or as many of them as the system allows
+   */
+  explicit
+  WorkerPool(size_t nWorkers);
+
+  ~WorkerPool();
+
+  /**
+   * @return the number of threads in the pool
+   */
+  size_t
+  size() const
+  {
+    return m_workers.size();
+  }
+
+  /**
+   * @brief Run @p work on the calling thread and on @p nWorkers threads of the pool, and
+   *        wait until all of them have returned
+   *
+   * Concurrent calls are run one after another.
+   *
+   * @pre @p work does not throw
+   */
+  void
+  run(size_t nWorkers, const std::function<void()>& work);
+
+private:
+  void
+  runWorker(size_t index);
+
+private:
+  std::mutex m_runMutex;
+  std::mutex m_mutex;
+  std::condition_variable m_hasWork;
+  std::condition_variable m_isDone;
+  const std::function<void()>* m_work;
+  size_t m_nParticipants;
+  size_t m_nRunning;
+  uint64_t m_generation;
+  bool m_isStopping;
+  std::vector<std::thread> m_workers;
+};
+
+} // namespace detail
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_DETAIL_WORKER_POOL_HPP
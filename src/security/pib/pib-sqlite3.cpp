@@ -33,6 +33,8 @@ namespace security {
 namespace pib {
 
 using util::Sqlite3Statement;
+using util::Sqlite3StatementCache;
+using util::Sqlite3Transaction;
 
 static const std::string INITIALIZATION = R"SQL(
 CREATE TABLE IF NOT EXISTS
@@ -235,10 +237,13 @@ PibSqlite3::PibSqlite3(const std::string& location)
     sqlite3_free(errorMessage);
     BOOST_THROW_EXCEPTION(PibImpl::Error("PIB DB cannot be initialized"));
   }
+
+  m_statements.reset(new Sqlite3StatementCache(m_database));
 }
 
 PibSqlite3::~PibSqlite3()
 {
+  m_statements.reset();
   sqlite3_close(m_database);
 }
 
@@ -249,25 +254,49 @@ PibSqlite3::getScheme()
   return scheme;
 }
 
+bool
+PibSqlite3::enableWriteAheadLog()
+{
+  {
+    Sqlite3Statement statement(m_database, "PRAGMA journal_mode=WAL");
+    if (statement.step() != SQLITE_ROW || !boost::iequals(statement.getString(0), "wal"))
+      return false;
+  }
+
+  // with WAL, NORMAL still keeps the database consistent, but saves a sync per transaction
+  sqlite3_exec(m_database, "PRAGMA synchronous=NORMAL", nullptr, nullptr, nullptr);
+  return true;
+}
+
+void
+PibSqlite3::runInTransaction(const std::function<void()>& mutations)
+{
+  Sqlite3Transaction transaction(m_database);
+  mutations();
+  transaction.commit();
+}
+
 void
 PibSqlite3::setTpmLocator(const std::string& tpmLocator)
 {
-  Sqlite3Statement statement(m_database, "UPDATE tpmInfo SET tpm_locator=?");
+  Sqlite3Transaction transaction(m_database);
+  Sqlite3Statement statement(*m_statements, "UPDATE tpmInfo SET tpm_locator=?");
   statement.bind(1, tpmLocator, SQLITE_TRANSIENT);
   statement.step();
 
   if (sqlite3_changes(m_database) == 0) {
     // no row is updated, tpm_locator does not exist, insert it directly
-    Sqlite3Statement insertStatement(m_database, "INSERT INTO tpmInfo (tpm_locator) values (?)");
+    Sqlite3Statement insertStatement(*m_statements, "INSERT INTO tpmInfo (tpm_locator) values (?)");
     insertStatement.bind(1, tpmLocator, SQLITE_TRANSIENT);
     insertStatement.step();
   }
+  transaction.commit();
 }
 
 std::string
 PibSqlite3::getTpmLocator() const
 {
-  Sqlite3Statement statement(m_database, "SELECT tpm_locator FROM tpmInfo");
+  Sqlite3Statement statement(*m_statements, "SELECT tpm_locator FROM tpmInfo");
   int res = statement.step();
   if (res == SQLITE_ROW)
     return statement.getString(0);
@@ -278,7 +307,7 @@ PibSqlite3::getTpmLocator() const
 bool
 PibSqlite3::hasIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM identities WHERE identity=?");
+  Sqlite3Statement statement(*m_statements, "SELECT id FROM identities WHERE identity=?");
   statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
   return (statement.step() == SQLITE_ROW);
 }
@@ -286,8 +315,9 @@ PibSqlite3::hasIdentity(const Name& identity) const
 void
 PibSqlite3::addIdentity(const Name& identity)
 {
+  Sqlite3Transaction transaction(m_database);
   if (!hasIdentity(identity)) {
-    Sqlite3Statement statement(m_database, "INSERT INTO identities (identity) values (?)");
+    Sqlite3Statement statement(*m_statements, "INSERT INTO identities (identity) values (?)");
     statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
     statement.step();
   }
@@ -295,12 +325,13 @@ PibSqlite3::addIdentity(const Name& identity)
   if (!hasDefaultIdentity()) {
     setDefaultIdentity(identity);
   }
+  transaction.commit();
 }
 
 void
 PibSqlite3::removeIdentity(const Name& identity)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities WHERE identity=?");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM identities WHERE identity=?");
   statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
 }
@@ -308,7 +339,7 @@ PibSqlite3::removeIdentity(const Name& identity)
 void
 PibSqlite3::clearIdentities()
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM identities");
   statement.step();
 }
 
@@ -316,7 +347,7 @@ std::set<Name>
 PibSqlite3::getIdentities() const
 {
   std::set<Name> identities;
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities");
+  Sqlite3Statement statement(*m_statements, "SELECT identity FROM identities");
 
   while (statement.step() == SQLITE_ROW)
     identities.insert(Name(statement.getBlock(0)));
@@ -327,7 +358,7 @@ PibSqlite3::getIdentities() const
 void
 PibSqlite3::setDefaultIdentity(const Name& identityName)
 {
-  Sqlite3Statement statement(m_database, "UPDATE identities SET is_default=1 WHERE identity=?");
+  Sqlite3Statement statement(*m_statements, "UPDATE identities SET is_default=1 WHERE identity=?");
   statement.bind(1, identityName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
 }
@@ -335,7 +366,7 @@ PibSqlite3::setDefaultIdentity(const Name& identityName)
 Name
 PibSqlite3::getDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
+  Sqlite3Statement statement(*m_statements, "SELECT identity FROM identities WHERE is_default=1");
 
   if (statement.step() == SQLITE_ROW)
     return Name(statement.getBlock(0));
@@ -346,14 +377,14 @@ PibSqlite3::getDefaultIdentity() const
 bool
 PibSqlite3::hasDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
+  Sqlite3Statement statement(*m_statements, "SELECT identity FROM identities WHERE is_default=1");
   return (statement.step() == SQLITE_ROW);
 }
 
 bool
 PibSqlite3::hasKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM keys WHERE key_name=?");
+  Sqlite3Statement statement(*m_statements, "SELECT id FROM keys WHERE key_name=?");
   statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
 
   return (statement.step() == SQLITE_ROW);
@@ -363,11 +394,13 @@ void
 PibSqlite3::addKey(const Name& identity, const Name& keyName,
                    const uint8_t* key, size_t keyLen)
 {
+  Sqlite3Transaction transaction(m_database);
+
   // ensure identity exists
   addIdentity(identity);
 
   if (!hasKey(keyName)) {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "INSERT INTO keys (identity_id, key_name, key_bits) "
                                "VALUES ((SELECT id FROM identities WHERE identity=?), ?, ?)");
     statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
@@ -376,7 +409,7 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
     statement.step();
   }
   else {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "UPDATE keys SET key_bits=? WHERE key_name=?");
     statement.bind(1, key, keyLen, SQLITE_STATIC);
     statement.bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
@@ -386,12 +419,13 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
   if (!hasDefaultKeyOfIdentity(identity)) {
     setDefaultKeyOfIdentity(identity, keyName);
   }
+  transaction.commit();
 }
 
 void
 PibSqlite3::removeKey(const Name& keyName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM keys WHERE key_name=?");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM keys WHERE key_name=?");
   statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
 }
@@ -399,7 +433,7 @@ PibSqlite3::removeKey(const Name& keyName)
 Buffer
 PibSqlite3::getKeyBits(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT key_bits FROM keys WHERE key_name=?");
+  Sqlite3Statement statement(*m_statements, "SELECT key_bits FROM keys WHERE key_name=?");
   statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
 
   if (statement.step() == SQLITE_ROW)
@@ -413,7 +447,7 @@ PibSqlite3::getKeysOfIdentity(const Name& identity) const
 {
   std::set<Name> keyNames;
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT key_name "
                              "FROM keys JOIN identities ON keys.identity_id=identities.id "
                              "WHERE identities.identity=?");
@@ -433,7 +467,7 @@ PibSqlite3::setDefaultKeyOfIdentity(const Name& identity, const Name& keyName)
     BOOST_THROW_EXCEPTION(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database, "UPDATE keys SET is_default=1 WHERE key_name=?");
+  Sqlite3Statement statement(*m_statements, "UPDATE keys SET is_default=1 WHERE key_name=?");
   statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
 }
@@ -445,7 +479,7 @@ PibSqlite3::getDefaultKeyOfIdentity(const Name& identity) const
     BOOST_THROW_EXCEPTION(Pib::Error("Identity `" + identity.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT key_name "
                              "FROM keys JOIN identities ON keys.identity_id=identities.id "
                              "WHERE identities.identity=? AND keys.is_default=1");
@@ -461,7 +495,7 @@ PibSqlite3::getDefaultKeyOfIdentity(const Name& identity) const
 bool
 PibSqlite3::hasDefaultKeyOfIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT key_name "
                              "FROM keys JOIN identities ON keys.identity_id=identities.id "
                              "WHERE identities.identity=? AND keys.is_default=1");
@@ -473,7 +507,7 @@ PibSqlite3::hasDefaultKeyOfIdentity(const Name& identity) const
 bool
 PibSqlite3::hasCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM certificates WHERE certificate_name=?");
+  Sqlite3Statement statement(*m_statements, "SELECT id FROM certificates WHERE certificate_name=?");
   statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
   return (statement.step() == SQLITE_ROW);
 }
@@ -481,12 +515,14 @@ PibSqlite3::hasCertificate(const Name& certName) const
 void
 PibSqlite3::addCertificate(const v2::Certificate& certificate)
 {
+  Sqlite3Transaction transaction(m_database);
+
   // ensure key exists
   const Block& content = certificate.getContent();
   addKey(certificate.getIdentity(), certificate.getKeyName(), content.value(), content.value_size());
 
   if (!hasCertificate(certificate.getName())) {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "INSERT INTO certificates "
                                "(key_id, certificate_name, certificate_data) "
                                "VALUES ((SELECT id FROM keys WHERE key_name=?), ?, ?)");
@@ -496,7 +532,7 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
     statement.step();
   }
   else {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "UPDATE certificates SET certificate_data=? WHERE certificate_name=?");
     statement.bind(1, certificate.wireEncode(), SQLITE_STATIC);
     statement.bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
@@ -506,12 +542,13 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
   if (!hasDefaultCertificateOfKey(certificate.getKeyName())) {
     setDefaultCertificateOfKey(certificate.getKeyName(), certificate.getName());
   }
+  transaction.commit();
 }
 
 void
 PibSqlite3::removeCertificate(const Name& certName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM certificates WHERE certificate_name=?");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM certificates WHERE certificate_name=?");
   statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
 }
@@ -519,7 +556,7 @@ PibSqlite3::removeCertificate(const Name& certName)
 v2::Certificate
 PibSqlite3::getCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT certificate_data FROM certificates WHERE certificate_name=?");
   statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
 
@@ -534,7 +571,7 @@ PibSqlite3::getCertificatesOfKey(const Name& keyName) const
 {
   std::set<Name> certNames;
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT certificate_name "
                              "FROM certificates JOIN keys ON certificates.key_id=keys.id "
                              "WHERE keys.key_name=?");
@@ -553,7 +590,7 @@ PibSqlite3::setDefaultCertificateOfKey(const Name& keyName, const Name& certName
     BOOST_THROW_EXCEPTION(Pib::Error("Certificate `" + certName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "UPDATE certificates SET is_default=1 WHERE certificate_name=?");
   statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
@@ -562,7 +599,7 @@ PibSqlite3::setDefaultCertificateOfKey(const Name& keyName, const Name& certName
 v2::Certificate
 PibSqlite3::getDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT certificate_data "
                              "FROM certificates JOIN keys ON certificates.key_id=keys.id "
                              "WHERE certificates.is_default=1 AND keys.key_name=?");
@@ -577,7 +614,7 @@ PibSqlite3::getDefaultCertificateOfKey(const Name& keyName) const
 bool
 PibSqlite3::hasDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT certificate_data "
                              "FROM certificates JOIN keys ON certificates.key_id=keys.id "
                              "WHERE certificates.is_default=1 AND keys.key_name=?");
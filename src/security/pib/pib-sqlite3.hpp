@@ -27,6 +27,11 @@
 struct sqlite3;
 
 namespace ndn {
+
+namespace util {
+class Sqlite3StatementCache;
+} // namespace util
+
 namespace security {
 namespace pib {
 
@@ -62,6 +67,29 @@ public:
   static const std::string&
   getScheme();
 
+  /**
+   * @brief Switch the database to the write-ahead log journal mode
+   *
+   * In this mode, readers do not block the writer and a transaction is committed without
+   * syncing the database file.  The mode is persistent, i.e., it stays in effect when the
+   * database is opened again.  It is not supported on network file systems, nor when the
+   * library is configured with --without-sqlite-locking, because the unix-dotfile VFS used
+   * then does not provide the shared memory that WAL needs.
+   *
+   * @return whether the database is in write-ahead log mode
+   */
+  bool
+  enableWriteAheadLog();
+
+  /**
+   * @brief Make the changes by @p mutations in one transaction
+   *
+   * The changes are committed together when @p mutations returns, or rolled back if it throws.
+   * Batching mutations saves the cost of committing each of them.
+   */
+  void
+  runInTransaction(const std::function<void()>& mutations);
+
 public: // TpmLocator management
   void
   setTpmLocator(const std::string& tpmLocator) final;
@@ -148,6 +176,7 @@ private:
 
 private:
   sqlite3* m_database;
+  unique_ptr<util::Sqlite3StatementCache> m_statements;
 };
 
 } // namespace pib
@@ -52,6 +52,7 @@ SigningInfo::SigningInfo(SignerType signerType,
   , m_name(signerName)
   , m_digestAlgorithm(DigestAlgorithm::SHA256)
   , m_info(signatureInfo)
+  , m_isManifestSigning(false)
 {
   BOOST_ASSERT(signerType == SIGNER_TYPE_NULL ||
                signerType == SIGNER_TYPE_ID ||
@@ -191,7 +192,8 @@ SigningInfo::operator==(const SigningInfo& rhs) const
   return getSignerType() == rhs.getSignerType() &&
     getSignerName() == rhs.getSignerName() &&
     getDigestAlgorithm() == rhs.getDigestAlgorithm() &&
-    getSignatureInfo() == rhs.getSignatureInfo();
+    getSignatureInfo() == rhs.getSignatureInfo() &&
+    isManifestSigning() == rhs.isManifestSigning();
 }
 
 } // namespace security
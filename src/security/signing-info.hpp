@@ -207,6 +207,28 @@ public:
     return m_digestAlgorithm;
   }
 
+  /**
+   * @brief Set whether KeyChain::signBatch signs the batch with a single signature over a
+   *        Merkle tree manifest, rather than signing each packet
+   *
+   * Other signing operations reject a SigningInfo with manifest signing enabled.
+   */
+  SigningInfo&
+  setManifestSigning(bool isManifestSigning)
+  {
+    m_isManifestSigning = isManifestSigning;
+    return *this;
+  }
+
+  /**
+   * @return Whether KeyChain::signBatch signs the batch with a Merkle tree manifest
+   */
+  bool
+  isManifestSigning() const
+  {
+    return m_isManifestSigning;
+  }
+
   /**
    * @brief Set a semi-prepared SignatureInfo;
    */
@@ -251,6 +273,7 @@ private:
   Key m_key;
   DigestAlgorithm m_digestAlgorithm;
   SignatureInfo m_info;
+  bool m_isManifestSigning;
 };
 
 std::ostream&
@@ -23,6 +23,7 @@
 #include "../../encoding/buffer-stream.hpp"
 #include "../transform.hpp"
 #include "../transform/private-key.hpp"
+#include "../detail/openssl.hpp"
 
 namespace ndn {
 namespace security {
@@ -36,6 +37,17 @@ KeyHandleMem::KeyHandleMem(shared_ptr<PrivateKey> key)
   BOOST_ASSERT(key != nullptr);
 }
 
+bool
+KeyHandleMem::allowsConcurrentSigning() const
+{
+#if OPENSSL_VERSION_NUMBER < 0x1010000fL
+  // the reference count of EVP_PKEY is not protected without locking callbacks
+  return false;
+#else
+  return true;
+#endif // OPENSSL_VERSION_NUMBER < 0x1010000fL
+}
+
 ConstBufferPtr
 KeyHandleMem::doSign(DigestAlgorithm digestAlgorithm, const uint8_t* buf, size_t size) const
 {
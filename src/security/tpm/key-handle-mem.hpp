@@ -42,6 +42,13 @@ public:
   explicit
   KeyHandleMem(shared_ptr<transform::PrivateKey> key);
 
+  /**
+   * @return whether the crypto library allows a private key to be used by several threads,
+   *         which is the case since OpenSSL 1.1.0
+   */
+  bool
+  allowsConcurrentSigning() const final;
+
 private:
   ConstBufferPtr
   doSign(DigestAlgorithm digestAlgorithm, const uint8_t* buf, size_t size) const final;
@@ -45,6 +45,12 @@ KeyHandle::derivePublicKey() const
   return doDerivePublicKey();
 }
 
+bool
+KeyHandle::allowsConcurrentSigning() const
+{
+  return false;
+}
+
 void
 KeyHandle::setKeyName(const Name& keyName)
 {
@@ -70,6 +70,14 @@ public:
   ConstBufferPtr
   derivePublicKey() const;
 
+  /**
+   * @brief Check whether sign() may be called concurrently from several threads
+   *
+   * Default implementation always returns false.
+   */
+  virtual bool
+  allowsConcurrentSigning() const;
+
   void
   setKeyName(const Name& keyName);
 
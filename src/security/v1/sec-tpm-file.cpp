@@ -36,6 +36,8 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <map>
+#include <mutex>
 
 namespace ndn {
 namespace security {
@@ -108,8 +110,137 @@ public:
     return keyFileName;
   }
 
+  /**
+   * @brief A private key decoded from its key file
+   *
+   * The decoded key is not modified after decoding, so it can be shared by all threads;
+   * each signing operation creates its own signer from it.
+   */
+  struct DecodedPrivateKey
+  {
+    KeyType keyType;
+    CryptoPP::RSA::PrivateKey rsaKey;
+    CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::PrivateKey ecKey;
+  };
+
+  /**
+   * @brief Decode the private key @p keyName, whose public key is of type @p keyType
+   */
+  shared_ptr<const DecodedPrivateKey>
+  decodePrivateKey(const Name& keyName, KeyType keyType)
+  {
+    using namespace CryptoPP;
+
+    ByteQueue bytes;
+    FileSource file(transformName(keyName.toUri(), ".pri").string().c_str(),
+                    true, new Base64Decoder);
+    file.TransferTo(bytes);
+    bytes.MessageEnd();
+
+    auto key = make_shared<DecodedPrivateKey>();
+    key->keyType = keyType;
+    switch (keyType) {
+      case KeyType::RSA:
+        key->rsaKey.Load(bytes);
+        break;
+      case KeyType::EC:
+        key->ecKey.Load(bytes);
+        break;
+      default:
+        BOOST_THROW_EXCEPTION(Error("Unsupported key type"));
+    }
+    return key;
+  }
+
+  /**
+   * @brief Sign @p data with @p key, using a random pool owned by the calling thread
+   */
+  static void
+  sign(const DecodedPrivateKey& key, const uint8_t* data, size_t dataLength, OBufferStream& os)
+  {
+    using namespace CryptoPP;
+
+    static thread_local AutoSeededRandomPool rng;
+
+    unique_ptr<PK_Signer> signer;
+    switch (key.keyType) {
+      case KeyType::RSA:
+        signer = make_unique<RSASS<PKCS1v15, SHA256>::Signer>(key.rsaKey);
+        break;
+      case KeyType::EC:
+        signer = make_unique<ECDSA<ECP, SHA256>::Signer>(key.ecKey);
+        break;
+      default:
+        BOOST_THROW_EXCEPTION(Error("Unsupported key type"));
+    }
+
+    StringSource(data, dataLength,
+                 true,
+                 new SignerFilter(rng, *signer, new FileSink(os)));
+  }
+
+  /**
+   * @brief Find the decoded private key @p keyName
+   * @param[out] generation the generation of the cache, to be passed to cachePrivateKey
+   * @return the decoded key, or nullptr if it is not cached
+   */
+  shared_ptr<const DecodedPrivateKey>
+  findPrivateKey(const Name& keyName, uint64_t& generation)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    generation = m_generation;
+    auto it = m_privateKeyCache.find(keyName);
+    return it == m_privateKeyCache.end() ? nullptr : it->second;
+  }
+
+  /**
+   * @brief Cache the private key @p keyName, decoded after findPrivateKey returned @p generation
+   *
+   * The key is not cached if any key files have changed since then, because it may have been
+   * decoded from the old files.
+   */
+  void
+  cachePrivateKey(const Name& keyName, const shared_ptr<const DecodedPrivateKey>& key,
+                  uint64_t generation)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (generation != m_generation) {
+      return;
+    }
+    if (m_privateKeyCache.size() >= MAX_CACHED_KEYS) {
+      m_privateKeyCache.erase(m_privateKeyCache.begin());
+    }
+    m_privateKeyCache[keyName] = key;
+  }
+
+  /**
+   * @brief Drop the decoded private key @p keyName, whose key files have been changed
+   * @note Call this after the key files have been written or removed.
+   */
+  void
+  forgetPrivateKey(const Name& keyName)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_privateKeyCache.erase(keyName);
+    ++m_generation;
+  }
+
 public:
   boost::filesystem::path m_keystorePath;
+
+private:
+  static const size_t MAX_CACHED_KEYS = 64;
+
+  /**
+   * @brief Decoded private keys, indexed by key name
+   *
+   * An entry is added when a key is used for signing for the first time, and is removed
+   * whenever the key files are changed through this TPM.  When the cache is full, the entry
+   * with the lowest key name is evicted.
+   */
+  std::map<Name, shared_ptr<const DecodedPrivateKey>> m_privateKeyCache;
+  uint64_t m_generation = 0; ///< incremented whenever key files are changed through this TPM
+  std::mutex m_mutex; ///< guards the cache only; keys are decoded and used without the lock
 };
 
 
@@ -160,6 +291,7 @@ SecTpmFile::generateKeyPairInTpm(const Name& keyName, const KeyParams& params)
         // set file permission
         chmod(privateKeyFileName.c_str(), 0000400);
         chmod(publicKeyFileName.c_str(), 0000444);
+        m_impl->forgetPrivateKey(keyName);
         return;
       }
 
@@ -205,6 +337,7 @@ SecTpmFile::generateKeyPairInTpm(const Name& keyName, const KeyParams& params)
         // set file permission
         chmod(privateKeyFileName.c_str(), 0000400);
         chmod(publicKeyFileName.c_str(), 0000444);
+        m_impl->forgetPrivateKey(keyName);
         return;
       }
 
@@ -231,6 +364,8 @@ SecTpmFile::deleteKeyPairInTpm(const Name& keyName)
 
   if (boost::filesystem::exists(privateKeyPath))
     boost::filesystem::remove(privateKeyPath);
+
+  m_impl->forgetPrivateKey(keyName);
 }
 
 shared_ptr<PublicKey>
@@ -283,6 +418,7 @@ SecTpmFile::importPrivateKeyPkcs8IntoTpm(const Name& keyName, const uint8_t* buf
     StringSource(buf, size,
                  true,
                  new Base64Encoder(new FileSink(keyFileName.c_str())));
+    m_impl->forgetPrivateKey(keyName);
     return true;
   }
   catch (const CryptoPP::Exception& e) {
@@ -301,6 +437,7 @@ SecTpmFile::importPublicKeyPkcs1IntoTpm(const Name& keyName, const uint8_t* buf,
     StringSource(buf, size,
                  true,
                  new Base64Encoder(new FileSink(keyFileName.c_str())));
+    m_impl->forgetPrivateKey(keyName);
     return true;
   }
   catch (const CryptoPP::Exception& e) {
@@ -312,81 +449,42 @@ Block
 SecTpmFile::signInTpm(const uint8_t* data, size_t dataLength,
                       const Name& keyName, DigestAlgorithm digestAlgorithm)
 {
-  string keyURI = keyName.toUri();
-
-  if (!doesKeyExistInTpm(keyName, KeyClass::PRIVATE))
-    BOOST_THROW_EXCEPTION(Error("private key doesn't exist"));
-
   try {
     using namespace CryptoPP;
-    AutoSeededRandomPool rng;
 
-    // Read public key
-    shared_ptr<PublicKey> pubkeyPtr;
-    pubkeyPtr = getPublicKeyFromTpm(keyName);
+    // the key files are looked at only when the key is not cached
+    uint64_t generation = 0;
+    shared_ptr<const Impl::DecodedPrivateKey> key = m_impl->findPrivateKey(keyName, generation);
+    if (key == nullptr) {
+      if (!doesKeyExistInTpm(keyName, KeyClass::PRIVATE))
+        BOOST_THROW_EXCEPTION(Error("private key doesn't exist"));
+
+      // the key type is determined by the public key
+      key = m_impl->decodePrivateKey(keyName, getPublicKeyFromTpm(keyName)->getKeyType());
+      m_impl->cachePrivateKey(keyName, key, generation);
+    }
+
+    if (digestAlgorithm != DigestAlgorithm::SHA256)
+      BOOST_THROW_EXCEPTION(Error("Unsupported digest algorithm"));
 
-    switch (pubkeyPtr->getKeyType()) {
+    // Sign message
+    OBufferStream os;
+    Impl::sign(*key, data, dataLength, os);
+
+    switch (key->keyType) {
       case KeyType::RSA: {
-        // Read private key
-        ByteQueue bytes;
-        FileSource file(m_impl->transformName(keyURI, ".pri").string().c_str(),
-                        true, new Base64Decoder);
-        file.TransferTo(bytes);
-        bytes.MessageEnd();
-        RSA::PrivateKey privateKey;
-        privateKey.Load(bytes);
-
-        // Sign message
-        switch (digestAlgorithm) {
-          case DigestAlgorithm::SHA256: {
-            RSASS<PKCS1v15, SHA256>::Signer signer(privateKey);
-
-            OBufferStream os;
-            StringSource(data, dataLength,
-                         true,
-                         new SignerFilter(rng, signer, new FileSink(os)));
-
-            return Block(tlv::SignatureValue, os.buf());
-          }
-
-          default:
-            BOOST_THROW_EXCEPTION(Error("Unsupported digest algorithm"));
-        }
+        return Block(tlv::SignatureValue, os.buf());
       }
 
       case KeyType::EC: {
-        // Read private key
-        ByteQueue bytes;
-        FileSource file(m_impl->transformName(keyURI, ".pri").string().c_str(),
-                        true, new Base64Decoder);
-        file.TransferTo(bytes);
-        bytes.MessageEnd();
-
-        // Sign message
-        switch (digestAlgorithm) {
-          case DigestAlgorithm::SHA256: {
-            ECDSA<ECP, SHA256>::PrivateKey privateKey;
-            privateKey.Load(bytes);
-            ECDSA<ECP, SHA256>::Signer signer(privateKey);
-
-            OBufferStream os;
-            StringSource(data, dataLength,
-                         true,
-                         new SignerFilter(rng, signer, new FileSink(os)));
-
-            uint8_t buf[200];
-            size_t bufSize = DSAConvertSignatureFormat(buf, sizeof(buf), DSA_DER,
-                                                       os.buf()->buf(), os.buf()->size(),
-                                                       DSA_P1363);
-
-            shared_ptr<Buffer> sigBuffer = make_shared<Buffer>(buf, bufSize);
-
-            return Block(tlv::SignatureValue, sigBuffer);
-          }
-
-          default:
-            BOOST_THROW_EXCEPTION(Error("Unsupported digest algorithm"));
-        }
+        uint8_t buf[200];
+        size_t bufSize = DSAConvertSignatureFormat(buf, sizeof(buf), DSA_DER,
+                                                   os.buf()->buf(), os.buf()->size(),
+                                                   DSA_P1363);
+
+        shared_ptr<Buffer> sigBuffer = make_shared<Buffer>(buf, bufSize);
+
+        return Block(tlv::SignatureValue, sigBuffer);
       }
 
       default:
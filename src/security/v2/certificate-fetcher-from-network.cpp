@@ -29,7 +29,6 @@ namespace v2 {
 
 NDN_LOG_INIT(ndn.security.v2.CertificateFetcher);
 
-#define NDN_LOG_DEBUG_DEPTH(x) NDN_LOG_DEBUG(std::string(state->getDepth() + 1, '>') << " " << x)
 #define NDN_LOG_TRACE_DEPTH(x) NDN_LOG_TRACE(std::string(state->getDepth() + 1, '>') << " " << x)
 
 CertificateFetcherFromNetwork::CertificateFetcherFromNetwork(Face& face)
@@ -41,73 +40,149 @@ void
 CertificateFetcherFromNetwork::doFetch(const shared_ptr<CertificateRequest>& certRequest,
                                        const shared_ptr<ValidationState>& state,
                                        const ValidationContinuation& continueValidation)
+{
+  const Name& certName = certRequest->m_interest.getName();
+  auto it = m_pendingFetches.find(certName);
+  if (it != m_pendingFetches.end()) {
+    NDN_LOG_TRACE_DEPTH("Joining the outstanding Interest for " << certName);
+    it->second.push_back({state, continueValidation});
+    return;
+  }
+
+  m_pendingFetches[certName].push_back({state, continueValidation});
+  expressInterest(certRequest);
+}
+
+void
+CertificateFetcherFromNetwork::expressInterest(const shared_ptr<CertificateRequest>& certRequest)
 {
   m_face.expressInterest(certRequest->m_interest,
                          [=] (const Interest& interest, const Data& data) {
-                           dataCallback(data, certRequest, state, continueValidation);
+                           dataCallback(data, certRequest);
                          },
                          [=] (const Interest& interest, const lp::Nack& nack) {
-                           nackCallback(nack, certRequest, state, continueValidation);
+                           nackCallback(nack, certRequest);
                          },
                          [=] (const Interest& interest) {
-                           timeoutCallback(certRequest, state, continueValidation);
+                           timeoutCallback(certRequest);
                          });
 }
 
 void
 CertificateFetcherFromNetwork::dataCallback(const Data& data,
-                                            const shared_ptr<CertificateRequest>& certRequest,
-                                            const shared_ptr<ValidationState>& state,
-                                            const ValidationContinuation& continueValidation)
+                                            const shared_ptr<CertificateRequest>& certRequest)
 {
-  NDN_LOG_DEBUG_DEPTH("Fetched certificate from network " << data.getName());
+  auto it = m_pendingFetches.find(certRequest->m_interest.getName());
+  if (it == m_pendingFetches.end()) {
+    return;
+  }
+  // resuming a state may request other certificates, which modifies m_pendingFetches
+  std::vector<Waiter> waiters = std::move(it->second);
+  m_pendingFetches.erase(it);
+
+  NDN_LOG_DEBUG("Fetched certificate from network " << data.getName() << " for "
+                << waiters.size() << " validation state(s)");
 
   Certificate cert;
   try {
     cert = Certificate(data);
   }
   catch (const tlv::Error& e) {
-    return state->fail({ValidationError::Code::MALFORMED_CERT, "Fetched a malformed certificate "
-                        "`" + data.getName().toUri() + "` (" + e.what() + ")"});
+    ValidationError error(ValidationError::Code::MALFORMED_CERT, "Fetched a malformed certificate "
+                          "`" + data.getName().toUri() + "` (" + e.what() + ")");
+    resumeWaiters(waiters, [&error] (const Waiter& waiter) { waiter.state->fail(error); });
+    return;
   }
-  continueValidation(cert, state);
+
+  // the first state validates the chain; the following ones skip the certificates that it has
+  // verified, once they reach them
+  resumeWaiters(waiters, [&cert] (const Waiter& waiter) {
+    waiter.continueValidation(cert, waiter.state);
+  });
 }
 
 void
 CertificateFetcherFromNetwork::nackCallback(const lp::Nack& nack,
-                                            const shared_ptr<CertificateRequest>& certRequest,
-                                            const shared_ptr<ValidationState>& state,
-                                            const ValidationContinuation& continueValidation)
+                                            const shared_ptr<CertificateRequest>& certRequest)
 {
-  NDN_LOG_DEBUG_DEPTH("NACK (" << nack.getReason() <<  ") while fetching certificate "
-                      << certRequest->m_interest.getName());
+  NDN_LOG_DEBUG("NACK (" << nack.getReason() <<  ") while fetching certificate "
+                << certRequest->m_interest.getName());
 
   --certRequest->m_nRetriesLeft;
   if (certRequest->m_nRetriesLeft >= 0) {
     // TODO implement delay for the the next fetch
-    fetch(certRequest, state, continueValidation);
+    retryPendingFetch(certRequest);
   }
   else {
-    state->fail({ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch certificate after all "
-                 "retries `" + certRequest->m_interest.getName().toUri() + "`"});
+    failPendingFetch(certRequest, {ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch "
+                     "certificate after all retries `" + certRequest->m_interest.getName().toUri() + "`"});
   }
 }
 
 void
-CertificateFetcherFromNetwork::timeoutCallback(const shared_ptr<CertificateRequest>& certRequest,
-                                               const shared_ptr<ValidationState>& state,
-                                               const ValidationContinuation& continueValidation)
+CertificateFetcherFromNetwork::timeoutCallback(const shared_ptr<CertificateRequest>& certRequest)
 {
-  NDN_LOG_DEBUG_DEPTH("Timeout while fetching certificate " << certRequest->m_interest.getName()
-                      << ", retrying");
+  NDN_LOG_DEBUG("Timeout while fetching certificate " << certRequest->m_interest.getName()
+                << ", retrying");
 
   --certRequest->m_nRetriesLeft;
   if (certRequest->m_nRetriesLeft >= 0) {
-    fetch(certRequest, state, continueValidation);
+    retryPendingFetch(certRequest);
   }
   else {
-    state->fail({ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch certificate after all "
-                 "retries `" + certRequest->m_interest.getName().toUri() + "`"});
+    failPendingFetch(certRequest, {ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch "
+                     "certificate after all retries `" + certRequest->m_interest.getName().toUri() + "`"});
+  }
+}
+
+void
+CertificateFetcherFromNetwork::retryPendingFetch(const shared_ptr<CertificateRequest>& certRequest)
+{
+  auto it = m_pendingFetches.find(certRequest->m_interest.getName());
+  if (it == m_pendingFetches.end()) {
+    return;
+  }
+  std::vector<Waiter> waiters = std::move(it->second);
+  m_pendingFetches.erase(it);
+
+  // the first state sends the Interest again, the following ones join it
+  resumeWaiters(waiters, [this, &certRequest] (const Waiter& waiter) {
+    fetch(certRequest, waiter.state, waiter.continueValidation);
+  });
+}
+
+void
+CertificateFetcherFromNetwork::failPendingFetch(const shared_ptr<CertificateRequest>& certRequest,
+                                                const ValidationError& error)
+{
+  auto it = m_pendingFetches.find(certRequest->m_interest.getName());
+  if (it == m_pendingFetches.end()) {
+    return;
+  }
+  std::vector<Waiter> waiters = std::move(it->second);
+  m_pendingFetches.erase(it);
+
+  resumeWaiters(waiters, [&error] (const Waiter& waiter) { waiter.state->fail(error); });
+}
+
+void
+CertificateFetcherFromNetwork::resumeWaiters(const std::vector<Waiter>& waiters,
+                                             const std::function<void(const Waiter&)>& resume)
+{
+  std::exception_ptr firstError;
+  for (const Waiter& waiter : waiters) {
+    try {
+      resume(waiter);
+    }
+    catch (...) {
+      if (firstError == nullptr) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+
+  if (firstError != nullptr) {
+    std::rethrow_exception(firstError);
   }
 }
 
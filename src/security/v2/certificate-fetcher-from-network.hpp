@@ -24,6 +24,8 @@
 
 #include "certificate-fetcher.hpp"
 
+#include <unordered_map>
+
 namespace ndn {
 
 namespace lp {
@@ -35,6 +37,10 @@ namespace v2 {
 
 /**
  * @brief Fetch missing keys from the network
+ *
+ * Concurrent requests for the same certificate name share a single Interest.  When the
+ * certificate is retrieved, or when all retries have failed, every waiting validation state is
+ * resumed in the order in which it has requested the certificate.
  */
 class CertificateFetcherFromNetwork : public CertificateFetcher
 {
@@ -48,13 +54,17 @@ protected:
           const ValidationContinuation& continueValidation) override;
 
 private:
+  /**
+   * @brief Express the Interest of @p certRequest on behalf of all waiting states
+   */
+  void
+  expressInterest(const shared_ptr<CertificateRequest>& certRequest);
+
   /**
    * @brief Callback invoked when certificate is retrieved.
    */
   void
-  dataCallback(const Data& data,
-               const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
-               const ValidationContinuation& continueValidation);
+  dataCallback(const Data& data, const shared_ptr<CertificateRequest>& certRequest);
 
   /**
    * @brief Callback invoked when interest for fetching certificate gets NACKed.
@@ -64,9 +74,7 @@ private:
    * @todo Delay retry for some amount of time
    */
   void
-  nackCallback(const lp::Nack& nack,
-               const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
-               const ValidationContinuation& continueValidation);
+  nackCallback(const lp::Nack& nack, const shared_ptr<CertificateRequest>& certRequest);
 
   /**
    * @brief Callback invoked when interest for fetching certificate times out.
@@ -74,8 +82,43 @@ private:
    * It will retry if certRequest->m_nRetriesLeft > 0
    */
   void
-  timeoutCallback(const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
-                  const ValidationContinuation& continueValidation);
+  timeoutCallback(const shared_ptr<CertificateRequest>& certRequest);
+
+  /**
+   * @brief Fetch again the certificate requested by @p certRequest for all waiting states
+   *
+   * Each state goes through fetch(), so that the retry is sent the same way as the first
+   * Interest and is satisfied from the certificate cache if possible.
+   */
+  void
+  retryPendingFetch(const shared_ptr<CertificateRequest>& certRequest);
+
+  /**
+   * @brief Fail all states waiting for the certificate requested by @p certRequest
+   */
+  void
+  failPendingFetch(const shared_ptr<CertificateRequest>& certRequest, const ValidationError& error);
+
+private:
+  struct Waiter
+  {
+    shared_ptr<ValidationState> state;
+    ValidationContinuation continueValidation;
+  };
+
+  /**
+   * @brief Invoke @p resume for each of @p waiters
+   *
+   * An exception thrown for one waiter does not prevent the others from being resumed; the
+   * first such exception is rethrown when all of them have been resumed.
+   */
+  static void
+  resumeWaiters(const std::vector<Waiter>& waiters, const std::function<void(const Waiter&)>& resume);
+
+  /**
+   * @brief States waiting for each certificate name with an outstanding Interest
+   */
+  std::unordered_map<Name, std::vector<Waiter>> m_pendingFetches;
 
 protected:
   Face& m_face;
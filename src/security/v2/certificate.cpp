@@ -109,6 +109,29 @@ Certificate::getPublicKey() const
   return Buffer(getContent().value(), getContent().value_size());
 }
 
+shared_ptr<const transform::PublicKey>
+Certificate::getParsedPublicKey() const
+{
+  const Block& content = getContent();
+  // a changed content is in a different buffer, because m_parsedKeyContent keeps the old one alive
+  if (m_parsedKey != nullptr &&
+      m_parsedKeyContent.value() == content.value() &&
+      m_parsedKeyContent.value_size() == content.value_size()) {
+    return m_parsedKey;
+  }
+
+  auto key = make_shared<transform::PublicKey>();
+  try {
+    key->loadPkcs8(content.value(), content.value_size());
+  }
+  catch (const transform::PublicKey::Error&) {
+    return nullptr;
+  }
+  m_parsedKeyContent = content;
+  m_parsedKey = key;
+  return m_parsedKey;
+}
+
 ValidityPeriod
 Certificate::getValidityPeriod() const
 {
@@ -26,6 +26,7 @@
 #define NDN_SECURITY_V2_CERTIFICATE_HPP
 
 #include "../../data.hpp"
+#include "../security-common.hpp"
 
 namespace ndn {
 namespace security {
@@ -135,6 +136,20 @@ public:
   Buffer
   getPublicKey() const;
 
+  /**
+   * @brief Get the public key, decoded for signature verification
+   *
+   * The key is decoded from the content on first use and kept with the certificate.  Copies
+   * of the certificate, such as those held by CertificateCache and TrustAnchorContainer,
+   * share the decoded key, so that repeated verifications under the same certificate do not
+   * parse the PKCS#8 encoding again.
+   *
+   * @return the decoded key, or nullptr if the content is not a valid public key
+   * @note Concurrent calls on the same Certificate object are not safe.
+   */
+  shared_ptr<const transform::PublicKey>
+  getParsedPublicKey() const;
+
   /**
    * @brief Get validity period of the certificate
    */
@@ -170,6 +185,10 @@ public:
   static const size_t MIN_CERT_NAME_LENGTH;
   static const size_t MIN_KEY_NAME_LENGTH;
   static const name::Component KEY_COMPONENT;
+
+private:
+  mutable Block m_parsedKeyContent; ///< content from which m_parsedKey was decoded
+  mutable shared_ptr<const transform::PublicKey> m_parsedKey;
 };
 
 std::ostream&
@@ -38,11 +38,17 @@
 #include "../transform/buffer-source.hpp"
 #include "../transform/private-key.hpp"
 #include "../transform/verifier-filter.hpp"
+#include "../detail/merkle-tree.hpp"
+#include "../detail/worker-pool.hpp"
 #include "../../encoding/buffer-stream.hpp"
 #include "../../util/crypto.hpp"
 
 #include <boost/lexical_cast.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace ndn {
 namespace security {
 
@@ -151,6 +157,8 @@ KeyChain::getDefaultSigningInfo()
   return signingInfo;
 }
 
+const size_t KeyChain::MAX_PREPARED_SIGNATURE_INFOS = 16;
+
 const KeyParams&
 KeyChain::getDefaultKeyParams()
 {
@@ -219,6 +227,8 @@ KeyChain::~KeyChain() = default;
 Identity
 KeyChain::createIdentity(const Name& identityName, const KeyParams& params)
 {
+  resetPreparedSignatureInfos();
+
   Identity id = m_pib->addIdentity(identityName);
 
   Key key;
@@ -245,6 +255,8 @@ KeyChain::deleteIdentity(const Identity& identity)
 {
   BOOST_ASSERT(static_cast<bool>(identity));
 
+  resetPreparedSignatureInfos();
+
   Name identityName = identity.getName();
 
   for (const auto& key : identity.getKeys()) {
@@ -259,6 +271,8 @@ KeyChain::setDefaultIdentity(const Identity& identity)
 {
   BOOST_ASSERT(static_cast<bool>(identity));
 
+  resetPreparedSignatureInfos();
+
   m_pib->setDefaultIdentity(identity.getName());
 }
 
@@ -267,6 +281,8 @@ KeyChain::createKey(const Identity& identity, const KeyParams& params)
 {
   BOOST_ASSERT(static_cast<bool>(identity));
 
+  resetPreparedSignatureInfos();
+
   // create key in TPM
   Name keyName = m_tpm->createKey(identity.getName(), params);
 
@@ -286,6 +302,8 @@ KeyChain::deleteKey(const Identity& identity, const Key& key)
   BOOST_ASSERT(static_cast<bool>(identity));
   BOOST_ASSERT(static_cast<bool>(key));
 
+  resetPreparedSignatureInfos();
+
   Name keyName = key.getName();
   if (identity.getName() != key.getIdentity()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("Identity `" + identity.getName().toUri() + "` "
@@ -302,6 +320,8 @@ KeyChain::setDefaultKey(const Identity& identity, const Key& key)
   BOOST_ASSERT(static_cast<bool>(identity));
   BOOST_ASSERT(static_cast<bool>(key));
 
+  resetPreparedSignatureInfos();
+
   if (identity.getName() != key.getIdentity())
     BOOST_THROW_EXCEPTION(std::invalid_argument("Identity `" + identity.getName().toUri() + "` "
                                                 "does match key `" + key.getName().toUri() + "`"));
@@ -314,6 +334,8 @@ KeyChain::addCertificate(const Key& key, const Certificate& certificate)
 {
   BOOST_ASSERT(static_cast<bool>(key));
 
+  resetPreparedSignatureInfos();
+
   if (key.getName() != certificate.getKeyName() ||
       !std::equal(certificate.getContent().value_begin(), certificate.getContent().value_end(),
                   key.getPublicKey().begin()))
@@ -328,6 +350,8 @@ KeyChain::deleteCertificate(const Key& key, const Name& certificateName)
 {
   BOOST_ASSERT(static_cast<bool>(key));
 
+  resetPreparedSignatureInfos();
+
   if (!Certificate::isValidName(certificateName)) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("Wrong certificate name `" + certificateName.toUri() + "`"));
   }
@@ -340,6 +364,8 @@ KeyChain::setDefaultCertificate(const Key& key, const Certificate& cert)
 {
   BOOST_ASSERT(static_cast<bool>(key));
 
+  resetPreparedSignatureInfos();
+
   try {
     addCertificate(key, cert);
   }
@@ -370,6 +396,8 @@ KeyChain::exportSafeBag(const Certificate& certificate, const char* pw, size_t p
 void
 KeyChain::importSafeBag(const SafeBag& safeBag, const char* pw, size_t pwLen)
 {
+  resetPreparedSignatureInfos();
+
   Data certData = safeBag.getCertificate();
   Certificate cert(std::move(certData));
   Name identity = cert.getIdentity();
@@ -431,6 +459,14 @@ KeyChain::importSafeBag(const SafeBag& safeBag, const char* pw, size_t pwLen)
 
 // public: signing
 
+/**
+ * @brief Room for SignatureValue reserved when encoding a Data packet for signing
+ *
+ * This fits the signatures of ECDSA keys and RSA keys up to 4096 bits.  A larger
+ * SignatureValue makes the EncodingBuffer grow.
+ */
+static const size_t MAX_SIGNATURE_VALUE_SIZE = 4 + 512;
+
 void
 KeyChain::sign(Data& data, const SigningInfo& params)
 {
@@ -440,7 +476,8 @@ KeyChain::sign(Data& data, const SigningInfo& params)
 
   data.setSignature(Signature(sigInfo));
 
-  EncodingBuffer encoder;
+  EncodingBuffer encoder(data.estimateSigningBufferSize(MAX_SIGNATURE_VALUE_SIZE),
+                         MAX_SIGNATURE_VALUE_SIZE);
   data.wireEncode(encoder, true);
 
   Block sigValue = sign(encoder.buf(), encoder.size(), keyName, params.getDigestAlgorithm());
@@ -448,6 +485,126 @@ KeyChain::sign(Data& data, const SigningInfo& params)
   data.wireEncode(encoder, sigValue);
 }
 
+void
+KeyChain::signBatch(std::vector<Data>& packets, const SigningInfo& params, size_t nThreads)
+{
+  if (params.isManifestSigning()) {
+    return signBatchWithManifest(packets, params);
+  }
+
+  Name keyName;
+  SignatureInfo sigInfo;
+  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
+  DigestAlgorithm digestAlgorithm = params.getDigestAlgorithm();
+
+  // look up the key handle here, because Tpm::findKey is not safe to call concurrently
+  const tpm::KeyHandle* key = nullptr;
+  if (keyName != SigningInfo::getDigestSha256Identity()) {
+    key = m_tpm->findKey(keyName);
+    if (key == nullptr) {
+      BOOST_THROW_EXCEPTION(Error("Private key `" + keyName.toUri() + "` does not exist"));
+    }
+  }
+
+  // all packets share the wire encoding of SignatureInfo
+  sigInfo.wireEncode();
+  for (Data& data : packets) {
+    data.setSignature(Signature(sigInfo));
+  }
+
+  auto signData = [key, digestAlgorithm] (Data& data) {
+    EncodingBuffer encoder(data.estimateSigningBufferSize(MAX_SIGNATURE_VALUE_SIZE),
+                           MAX_SIGNATURE_VALUE_SIZE);
+    data.wireEncode(encoder, true);
+
+    ConstBufferPtr sigBits = key == nullptr ? crypto::sha256(encoder.buf(), encoder.size()) :
+                                              key->sign(digestAlgorithm, encoder.buf(), encoder.size());
+    if (sigBits == nullptr) {
+      BOOST_THROW_EXCEPTION(Error("Failed to sign `" + data.getName().toUri() + "`"));
+    }
+
+    data.wireEncode(encoder, Block(tlv::SignatureValue, sigBits));
+  };
+
+  if (nThreads == 0) {
+    nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  nThreads = std::min(nThreads, packets.size());
+  if (key != nullptr && !key->allowsConcurrentSigning()) {
+    nThreads = 1;
+  }
+
+  if (nThreads <= 1) {
+    for (Data& data : packets) {
+      signData(data);
+    }
+    return;
+  }
+
+  if (m_signingWorkers == nullptr || m_signingWorkers->size() < nThreads - 1) {
+    m_signingWorkers.reset(); // stop the old threads first
+    m_signingWorkers = make_unique<detail::WorkerPool>(nThreads - 1);
+  }
+
+  std::atomic<size_t> next(0);
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto work = [&] {
+    try {
+      for (size_t i = next++; i < packets.size(); i = next++) {
+        signData(packets[i]);
+      }
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+      next = packets.size();
+    }
+  };
+
+  m_signingWorkers->run(nThreads - 1, work);
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+void
+KeyChain::signBatchWithManifest(std::vector<Data>& packets, const SigningInfo& params)
+{
+  if (packets.size() < 2) {
+    BOOST_THROW_EXCEPTION(Error("Signing with a manifest needs at least one packet and the manifest"));
+  }
+  Data& manifest = packets.back();
+
+  SignatureInfo sigInfo(tlv::SignatureSha256WithMerkleProof, KeyLocator(manifest.getName()));
+  sigInfo.wireEncode();
+
+  std::vector<security::detail::MerkleTree::Digest> leaves;
+  leaves.reserve(packets.size() - 1);
+  for (auto data = packets.begin(); data != packets.end() - 1; ++data) {
+    data->setSignature(Signature(sigInfo));
+
+    EncodingBuffer encoder;
+    data->wireEncode(encoder, true);
+    leaves.push_back(security::detail::MerkleTree::hashLeaf(encoder.buf(), encoder.size()));
+  }
+
+  security::detail::MerkleTree tree(std::move(leaves));
+  for (size_t i = 0; i < packets.size() - 1; ++i) {
+    EncodingBuffer encoder;
+    packets[i].wireEncode(encoder, true);
+
+    Buffer proof = tree.getProof(i);
+    packets[i].wireEncode(encoder, makeBinaryBlock(tlv::SignatureValue, proof.data(), proof.size()));
+  }
+
+  manifest.setContent(tree.getRoot().data(), tree.getRoot().size());
+  sign(manifest, SigningInfo(params).setManifestSigning(false));
+}
+
 void
 KeyChain::sign(Interest& interest, const SigningInfo& params)
 {
@@ -581,6 +738,60 @@ KeyChain::selfSign(Key& key)
 
 std::tuple<Name, SignatureInfo>
 KeyChain::prepareSignatureInfo(const SigningInfo& params)
+{
+  if (params.isManifestSigning()) {
+    BOOST_THROW_EXCEPTION(InvalidSigningInfoError("Manifest signing is only supported by signBatch"));
+  }
+
+  // SigningInfos that carry a PIB handle may refer to another PIB, so they are not cached
+  bool isCacheable = false;
+  switch (params.getSignerType()) {
+    case SigningInfo::SIGNER_TYPE_NULL:
+    case SigningInfo::SIGNER_TYPE_CERT:
+      isCacheable = true;
+      break;
+    case SigningInfo::SIGNER_TYPE_ID:
+      isCacheable = !params.getPibIdentity();
+      break;
+    case SigningInfo::SIGNER_TYPE_KEY:
+      isCacheable = !params.getPibKey();
+      break;
+    case SigningInfo::SIGNER_TYPE_SHA256:
+      break;
+  }
+
+  if (isCacheable) {
+    for (const auto& prepared : m_preparedSignatureInfos) {
+      if (prepared.params == params &&
+          (prepared.key || prepared.keyName == SigningInfo::getDigestSha256Identity())) {
+        return std::make_tuple(prepared.keyName, prepared.sigInfo);
+      }
+    }
+  }
+
+  Key key;
+  Name keyName;
+  SignatureInfo sigInfo;
+  std::tie(keyName, sigInfo) = resolveSignatureInfo(params, key);
+
+  if (isCacheable) {
+    if (m_preparedSignatureInfos.size() >= MAX_PREPARED_SIGNATURE_INFOS) {
+      m_preparedSignatureInfos.clear();
+    }
+    sigInfo.wireEncode();
+    m_preparedSignatureInfos.push_back({params, key, keyName, sigInfo});
+  }
+  return std::make_tuple(keyName, sigInfo);
+}
+
+void
+KeyChain::resetPreparedSignatureInfos()
+{
+  m_preparedSignatureInfos.clear();
+}
+
+std::tuple<Name, SignatureInfo>
+KeyChain::resolveSignatureInfo(const SigningInfo& params, Key& key)
 {
   SignatureInfo sigInfo = params.getSignatureInfo();
 
@@ -589,7 +800,7 @@ KeyChain::prepareSignatureInfo(const SigningInfo& params)
   Name certificateName;
 
   pib::Identity identity;
-  pib::Key key;
+  key = Key();
 
   switch (params.getSignerType()) {
     case SigningInfo::SIGNER_TYPE_NULL: {
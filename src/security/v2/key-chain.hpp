@@ -33,6 +33,11 @@
 
 namespace ndn {
 namespace security {
+
+namespace detail {
+class WorkerPool;
+} // namespace detail
+
 namespace v2 {
 
 /**
@@ -260,6 +265,40 @@ public: // signing
   void
   sign(Data& data, const SigningInfo& params = getDefaultSigningInfo());
 
+  /**
+   * @brief Sign a batch of Data packets according to the supplied signing information
+   *
+   * The signing key and the SignatureInfo are resolved once for the whole batch, as in
+   * sign(Data&, const SigningInfo&).  Encoding and signing the packets are then spread over
+   * @p nThreads threads, one of which is the calling thread.  The other threads are started
+   * by the first call that needs them, and are kept by the KeyChain for later calls.  Every
+   * packet ends up signed as if sign(Data&, const SigningInfo&) had been called on it.
+   *
+   * If manifest signing is enabled in @p params, the last packet of @p packets is a manifest,
+   * whose name must be final and whose content is overwritten.  The signed portions of the
+   * other packets are hashed into a Merkle tree, and only the manifest, which carries the
+   * tree root as its content, is signed according to @p params.  Each other packet gets a
+   * SignatureSha256WithMerkleProof signature, whose KeyLocator is the name of the manifest
+   * and whose SignatureValue is the digest path from the packet to the root.  Once the
+   * manifest is validated, each packet can be verified with a few hash computations.
+   * @p nThreads is not used in this mode.
+   *
+   * @param packets The packets to sign
+   * @param params The signing parameters.
+   * @param nThreads The number of signing threads; 0 selects the number of hardware threads.
+   * @throw Error signing fails; some packets may have been signed nonetheless; or manifest
+   *              signing is enabled and @p packets holds fewer than two packets
+   * @throw InvalidSigningInfoError when the requested signing method cannot be satisfied.
+   * @see SigningInfo::setManifestSigning, verifyMerkleProof, Validator::validateManifest
+   *
+   * @note If the key handle of the TPM back-end does not allow concurrent signing (see
+   *       tpm::KeyHandle::allowsConcurrentSigning), the packets are signed on the calling
+   *       thread only.
+   */
+  void
+  signBatch(std::vector<Data>& packets, const SigningInfo& params = getDefaultSigningInfo(),
+            size_t nThreads = 0);
+
   /**
    * @brief Sign interest according to the supplied signing information
    *
@@ -426,6 +465,32 @@ private: // signing
   std::tuple<Name, SignatureInfo>
   prepareSignatureInfo(const SigningInfo& params);
 
+  /**
+   * @brief Resolve the signing key of @p params in PIB and prepare the SignatureInfo
+   *
+   * @param params The signing parameters.
+   * @param[out] key The resolved signing key, unset when signing with SHA-256 digest.
+   * @return The signing key name and prepared SignatureInfo.
+   * @throw InvalidSigningInfoError when the requested signing method cannot be satisfied.
+   */
+  std::tuple<Name, SignatureInfo>
+  resolveSignatureInfo(const SigningInfo& params, Key& key);
+
+  /**
+   * @brief Sign all but the last packet of @p packets with Merkle proofs, and sign the last
+   *        packet, the manifest, according to @p params
+   *
+   * @see signBatch
+   */
+  void
+  signBatchWithManifest(std::vector<Data>& packets, const SigningInfo& params);
+
+  /**
+   * @brief Forget the prepared SignatureInfos, because PIB is changed
+   */
+  void
+  resetPreparedSignatureInfos();
+
   /**
    * @brief Generate a SignatureValue block for a buffer @p buf with size @p size using
    *        a key with name @p keyName and digest algorithm @p digestAlgorithm.
@@ -441,9 +506,34 @@ public:
   getDefaultKeyParams();
 
 private:
+  /**
+   * @brief SignatureInfo prepared for a SigningInfo
+   */
+  struct PreparedSignatureInfo
+  {
+    SigningInfo params;
+    Key key; ///< the signing key, becomes invalid when the key is deleted from PIB
+    Name keyName;
+    SignatureInfo sigInfo; ///< with wire encoding, shared by the signed packets
+  };
+
   std::unique_ptr<Pib> m_pib;
   std::unique_ptr<Tpm> m_tpm;
 
+  /**
+   * @brief SignatureInfos prepared for SigningInfos that name the signer
+   *
+   * The entries are found by SigningInfo::operator==.  They are dropped when the KeyChain
+   * changes PIB, and all of them when there are too many.
+   */
+  std::vector<PreparedSignatureInfo> m_preparedSignatureInfos;
+  static const size_t MAX_PREPARED_SIGNATURE_INFOS;
+
+  /**
+   * @brief Threads that sign with the calling thread in signBatch
+   */
+  unique_ptr<detail::WorkerPool> m_signingWorkers;
+
   static std::string s_defaultPibLocator;
   static std::string s_defaultTpmLocator;
 };
@@ -27,16 +27,23 @@ namespace ndn {
 namespace security {
 namespace v2 {
 
+TrustAnchorContainer::AnchorContainer::AnchorContainer()
+  : generation(0)
+{
+}
+
 void
 TrustAnchorContainer::AnchorContainer::add(Certificate&& cert)
 {
   AnchorContainerBase::insert(std::move(cert));
+  ++generation;
 }
 
 void
 TrustAnchorContainer::AnchorContainer::remove(const Name& certName)
 {
   AnchorContainerBase::erase(certName);
+  ++generation;
 }
 
 void
@@ -106,6 +113,14 @@ TrustAnchorContainer::size() const
   return m_anchors.size();
 }
 
+uint64_t
+TrustAnchorContainer::getGeneration() const
+{
+  const_cast<TrustAnchorContainer*>(this)->refresh();
+
+  return m_anchors.generation;
+}
+
 void
 TrustAnchorContainer::refresh()
 {
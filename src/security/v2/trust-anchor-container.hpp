@@ -132,6 +132,14 @@ public:
   size_t
   size() const;
 
+  /**
+   * @brief Get a number that changes whenever a trust anchor is added or removed
+   *
+   * Dynamic anchor groups that are due for a refresh are refreshed before the number is returned.
+   */
+  uint64_t
+  getGeneration() const;
+
 private:
   void
   refresh();
@@ -150,11 +158,16 @@ private:
                           public AnchorContainerBase
   {
   public:
+    AnchorContainer();
+
     void
     add(Certificate&& cert) final;
 
     void
     remove(const Name& certName) final;
+
+  public:
+    uint64_t generation; ///< incremented on every change
   };
 
   using GroupContainer = boost::multi_index::multi_index_container<
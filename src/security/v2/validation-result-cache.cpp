@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "validation-result-cache.hpp"
+
+#include <cstring>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+size_t
+ValidationResultCache::DigestHash::operator()(const Digest& digest) const
+{
+  // the digest is uniformly distributed, so any of its bytes make a good hash
+  size_t hash;
+  std::memcpy(&hash, digest.data(), sizeof(hash));
+  return hash;
+}
+
+ValidationResultCache::ValidationResultCache(size_t capacity, const time::nanoseconds& maxLifetime)
+  : m_capacity(capacity)
+  , m_maxLifetime(maxLifetime)
+  , m_nHits(0)
+  , m_nMisses(0)
+{
+  BOOST_ASSERT(m_capacity > 0);
+  m_index.reserve(m_capacity);
+}
+
+bool
+ValidationResultCache::toDigest(const name::Component& implicitDigest, Digest& digest)
+{
+  if (!implicitDigest.isImplicitSha256Digest()) {
+    return false;
+  }
+  std::copy(implicitDigest.value_begin(), implicitDigest.value_end(), digest.begin());
+  return true;
+}
+
+const ValidationError*
+ValidationResultCache::find(const name::Component& implicitDigest)
+{
+  Digest digest;
+  if (!toDigest(implicitDigest, digest)) {
+    ++m_nMisses;
+    return nullptr;
+  }
+
+  auto it = m_index.find(digest);
+  if (it == m_index.end()) {
+    ++m_nMisses;
+    return nullptr;
+  }
+
+  if (it->second->expiry < time::system_clock::now()) {
+    m_entries.erase(it->second);
+    m_index.erase(it);
+    ++m_nMisses;
+    return nullptr;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  ++m_nHits;
+  return &it->second->outcome;
+}
+
+void
+ValidationResultCache::insert(const name::Component& implicitDigest, const ValidationError& outcome,
+                              const time::system_clock::TimePoint& expiry)
+{
+  Digest digest;
+  if (!toDigest(implicitDigest, digest)) {
+    return;
+  }
+
+  auto now = time::system_clock::now();
+  auto removalTime = std::min(expiry, now + m_maxLifetime);
+  if (removalTime < now) {
+    return;
+  }
+
+  auto it = m_index.find(digest);
+  if (it != m_index.end()) {
+    it->second->outcome = outcome;
+    it->second->expiry = removalTime;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  if (m_entries.size() >= m_capacity) {
+    m_index.erase(m_entries.back().digest);
+    m_entries.pop_back();
+  }
+
+  m_entries.push_front(Entry{digest, outcome, removalTime});
+  m_index.emplace(digest, m_entries.begin());
+}
+
+void
+ValidationResultCache::clear()
+{
+  m_entries.clear();
+  m_index.clear();
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_SECURITY_V2_VALIDATION_RESULT_CACHE_HPP
+#define NDN_SECURITY_V2_VALIDATION_RESULT_CACHE_HPP
+
+#include "validation-error.hpp"
+#include "../../name-component.hpp"
+#include "../../util/crypto.hpp"
+#include "../../util/time.hpp"
+
+#include <array>
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Represents a bounded cache of validation outcomes of Data packets.
+ *
+ * Outcomes are keyed by the implicit SHA-256 digest of the packet, so that a later validation
+ * of the identical packet can reuse the outcome.  An outcome is removed no later than its
+ * expiration time, which the validator derives from the validity periods of the certificates
+ * used in the validation.  When the cache is full, the least recently used outcome is evicted.
+ */
+class ValidationResultCache : noncopyable
+{
+public:
+  /**
+   * @brief Create a validation result cache
+   *
+   * @param capacity    the maximum number of outcomes, must be positive
+   * @param maxLifetime the maximum time that an outcome could live inside cache (default: 1 hour)
+   */
+  explicit
+  ValidationResultCache(size_t capacity, const time::nanoseconds& maxLifetime = time::hours(1));
+
+  /**
+   * @brief Find the outcome for the packet with @p implicitDigest
+   *
+   * @return The outcome, in which code NO_ERROR means successful validation; nullptr if there
+   *         is no unexpired outcome.
+   * @note The returned value may be invalidated after next call to insert.
+   */
+  const ValidationError*
+  find(const name::Component& implicitDigest);
+
+  /**
+   * @brief Insert @p outcome for the packet with @p implicitDigest
+   *
+   * The outcome will be removed no later than @p expiry, or maxLifetime defined during cache
+   * construction.
+   */
+  void
+  insert(const name::Component& implicitDigest, const ValidationError& outcome,
+         const time::system_clock::TimePoint& expiry = time::system_clock::TimePoint::max());
+
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * @return number of find calls that returned an outcome
+   */
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /**
+   * @return number of find calls that returned nullptr
+   */
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+private:
+  typedef std::array<uint8_t, crypto::SHA256_DIGEST_SIZE> Digest;
+
+  struct DigestHash
+  {
+    size_t
+    operator()(const Digest& digest) const;
+  };
+
+  struct Entry
+  {
+    Digest digest;
+    ValidationError outcome;
+    time::system_clock::TimePoint expiry;
+  };
+
+  typedef std::list<Entry> EntryList;
+
+  static bool
+  toDigest(const name::Component& implicitDigest, Digest& digest);
+
+private:
+  size_t m_capacity;
+  time::nanoseconds m_maxLifetime;
+
+  EntryList m_entries; ///< most recently used first
+  std::unordered_map<Digest, EntryList::iterator, DigestHash> m_index;
+
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_VALIDATION_RESULT_CACHE_HPP
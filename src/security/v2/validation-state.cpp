@@ -35,6 +35,8 @@ NDN_LOG_INIT(ndn.security.v2.ValidationState);
 
 ValidationState::ValidationState()
   : m_hasOutcome(false)
+  , m_certificateExpiry(time::system_clock::TimePoint::max())
+  , m_hasRequestedCertificate(false)
 {
 }
 
@@ -65,24 +67,51 @@ ValidationState::addCertificate(const Certificate& cert)
 const Certificate*
 ValidationState::verifyCertificateChain(const Certificate& trustedCert)
 {
-  const Certificate* validatedCert = &trustedCert;
-  for (auto it = m_certificateChain.begin(); it != m_certificateChain.end(); ++it) {
-    const auto& certToValidate = *it;
+  return finishCertificateChain(trustedCert, checkCertificateChain(trustedCert));
+}
 
+size_t
+ValidationState::checkCertificateChain(const Certificate& trustedCert) const
+{
+  const Certificate* validatedCert = &trustedCert;
+  size_t nValid = 0;
+  for (const auto& certToValidate : m_certificateChain) {
     if (!verifySignature(certToValidate, *validatedCert)) {
-      this->fail({ValidationError::Code::INVALID_SIGNATURE, "Invalid signature of certificate `" +
-                  certToValidate.getName().toUri() + "`"});
-      m_certificateChain.erase(it, m_certificateChain.end());
-      return nullptr;
-    }
-    else {
-      NDN_LOG_TRACE_DEPTH("OK signature for certificate `" << certToValidate.getName() << "`");
-      validatedCert = &certToValidate;
+      break;
     }
+    validatedCert = &certToValidate;
+    ++nValid;
+  }
+  return nValid;
+}
+
+const Certificate*
+ValidationState::finishCertificateChain(const Certificate& trustedCert, size_t nValid)
+{
+  BOOST_ASSERT(nValid <= m_certificateChain.size());
+
+  const Certificate* validatedCert = &trustedCert;
+  auto it = m_certificateChain.begin();
+  for (size_t i = 0; i < nValid; ++i, ++it) {
+    NDN_LOG_TRACE_DEPTH("OK signature for certificate `" << it->getName() << "`");
+    validatedCert = &*it;
+  }
+
+  if (it != m_certificateChain.end()) {
+    this->fail({ValidationError::Code::INVALID_SIGNATURE, "Invalid signature of certificate `" +
+                it->getName().toUri() + "`"});
+    m_certificateChain.erase(it, m_certificateChain.end());
+    return nullptr;
   }
   return validatedCert;
 }
 
+void
+ValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+{
+  finishOriginalPacket(checkOriginalPacket(trustedCert));
+}
+
 /////// DataValidationState
 
 DataValidationState::DataValidationState(const Data& data,
@@ -104,10 +133,16 @@ DataValidationState::~DataValidationState()
   }
 }
 
+bool
+DataValidationState::checkOriginalPacket(const Certificate& trustedCert) const
+{
+  return verifySignature(m_data, trustedCert);
+}
+
 void
-DataValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+DataValidationState::finishOriginalPacket(bool isSignatureValid)
 {
-  if (verifySignature(m_data, trustedCert)) {
+  if (isSignatureValid) {
     NDN_LOG_TRACE_DEPTH("OK signature for data `" << m_data.getName() << "`");
     m_successCb(m_data);
     BOOST_ASSERT(!m_hasOutcome);
@@ -164,10 +199,16 @@ InterestValidationState::~InterestValidationState()
   }
 }
 
+bool
+InterestValidationState::checkOriginalPacket(const Certificate& trustedCert) const
+{
+  return verifySignature(m_interest, trustedCert);
+}
+
 void
-InterestValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+InterestValidationState::finishOriginalPacket(bool isSignatureValid)
 {
-  if (verifySignature(m_interest, trustedCert)) {
+  if (isSignatureValid) {
     NDN_LOG_TRACE_DEPTH("OK signature for interest `" << m_interest.getName() << "`");
     m_successCb(m_interest);
     BOOST_ASSERT(!m_hasOutcome);
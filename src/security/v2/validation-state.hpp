@@ -101,8 +101,23 @@ private: // Interface intended to be used only by Validator class
    *
    * @param trustCert The certificate that signs the original packet
    */
+  void
+  verifyOriginalPacket(const Certificate& trustedCert);
+
+  /**
+   * @brief Check signature of the original packet, without invoking any callback
+   *
+   * @note This method does not modify the state, and may be invoked on a thread other than
+   *       the one running the validator.
+   */
+  virtual bool
+  checkOriginalPacket(const Certificate& trustedCert) const = 0;
+
+  /**
+   * @brief Call success or failure callback according to the outcome of checkOriginalPacket
+   */
   virtual void
-  verifyOriginalPacket(const Certificate& trustedCert) = 0;
+  finishOriginalPacket(bool isSignatureValid) = 0;
 
   /**
    * @brief Call success callback of the original packet without signature validation
@@ -127,6 +142,25 @@ private: // Interface intended to be used only by Validator class
   const Certificate*
   verifyCertificateChain(const Certificate& trustedCert);
 
+  /**
+   * @brief Check signatures of certificates in the certificate chain, without modifying the state
+   *
+   * @return The number of certificates at the beginning of m_certificateChain whose signatures
+   *         are valid.
+   * @note This method may be invoked on a thread other than the one running the validator.
+   */
+  size_t
+  checkCertificateChain(const Certificate& trustedCert) const;
+
+  /**
+   * @brief Apply the outcome of checkCertificateChain
+   *
+   * @param nValid The value returned by checkCertificateChain(trustedCert)
+   * @return Same as verifyCertificateChain(trustedCert)
+   */
+  const Certificate*
+  finishCertificateChain(const Certificate& trustedCert, size_t nValid);
+
 protected:
   bool m_hasOutcome;
 
@@ -141,6 +175,17 @@ private:
    */
   std::list<v2::Certificate> m_certificateChain;
 
+  /**
+   * @brief the earliest NotAfter time of the certificates that the outcome depends on
+   */
+  time::system_clock::TimePoint m_certificateExpiry;
+
+  /**
+   * @brief whether a certificate has been requested, so that the outcome may depend on
+   *        certificates retrieved from the network
+   */
+  bool m_hasRequestedCertificate;
+
   friend class Validator;
 };
 
@@ -178,8 +223,11 @@ public:
   getOriginalData() const;
 
 private:
+  bool
+  checkOriginalPacket(const Certificate& trustedCert) const final;
+
   void
-  verifyOriginalPacket(const Certificate& trustedCert) final;
+  finishOriginalPacket(bool isSignatureValid) final;
 
   void
   bypassValidation() final;
@@ -224,8 +272,11 @@ public:
   getOriginalInterest() const;
 
 private:
+  bool
+  checkOriginalPacket(const Certificate& trustedCert) const final;
+
   void
-  verifyOriginalPacket(const Certificate& trustedCert) final;
+  finishOriginalPacket(bool isSignatureValid) final;
 
   void
   bypassValidation() final;
@@ -23,6 +23,7 @@
 
 #include "face.hpp"
 #include "security/transform/public-key.hpp"
+#include "security/verification-helpers.hpp"
 #include "util/logger.hpp"
 
 namespace ndn {
@@ -31,13 +32,29 @@ namespace v2 {
 
 NDN_LOG_INIT(ndn.security.v2.Validator);
 
+const size_t Validator::MAX_VERIFIED_MANIFESTS = 1024;
+const time::nanoseconds Validator::MAX_MANIFEST_LIFETIME = time::hours(1);
+
 #define NDN_LOG_DEBUG_DEPTH(x) NDN_LOG_DEBUG(std::string(state->getDepth() + 1, '>') << " " << x)
 #define NDN_LOG_TRACE_DEPTH(x) NDN_LOG_TRACE(std::string(state->getDepth() + 1, '>') << " " << x)
 
+static time::system_clock::TimePoint
+getCertificateExpiry(const Certificate& cert)
+{
+  try {
+    return cert.getValidityPeriod().getPeriod().second;
+  }
+  catch (const tlv::Error&) {
+    return time::system_clock::TimePoint::max();
+  }
+}
+
 Validator::Validator(unique_ptr<ValidationPolicy> policy, unique_ptr<CertificateFetcher> certFetcher)
   : m_policy(std::move(policy))
   , m_certFetcher(std::move(certFetcher))
   , m_maxDepth(25)
+  , m_manifestAnchorGeneration(0)
+  , m_resultCacheAnchorGeneration(0)
 {
   BOOST_ASSERT(m_policy != nullptr);
   BOOST_ASSERT(m_certFetcher != nullptr);
@@ -58,14 +75,92 @@ Validator::getMaxDepth() const
   return m_maxDepth;
 }
 
+void
+Validator::setVerificationExecutor(unique_ptr<VerificationExecutor> executor)
+{
+  m_verificationExecutor = std::move(executor);
+}
+
+void
+Validator::setValidationResultCache(unique_ptr<ValidationResultCache> cache)
+{
+  m_resultCache = std::move(cache);
+  m_resultCacheAnchorGeneration = m_trustAnchors.getGeneration();
+}
+
+ValidationResultCache*
+Validator::getValidationResultCache() const
+{
+  return m_resultCache.get();
+}
+
 void
 Validator::validate(const Data& data,
                     const DataValidationSuccessCallback& successCb,
                     const DataValidationFailureCallback& failureCb)
 {
-  auto state = make_shared<DataValidationState>(data, successCb, failureCb);
+  shared_ptr<DataValidationState> state;
+  if (m_resultCache == nullptr || !data.hasWire() ||
+      // checking a Merkle proof is as cheap as a cache lookup
+      data.getSignature().getType() == tlv::SignatureSha256WithMerkleProof) {
+    state = make_shared<DataValidationState>(data, successCb, failureCb);
+  }
+  else {
+    // outcomes obtained with a different set of trust anchors may no longer hold
+    uint64_t anchorGeneration = m_trustAnchors.getGeneration();
+    if (anchorGeneration != m_resultCacheAnchorGeneration) {
+      NDN_LOG_DEBUG("Trust anchors have changed, clearing validation result cache");
+      m_resultCache->clear();
+      m_resultCacheAnchorGeneration = anchorGeneration;
+    }
+
+    name::Component digest = data.getFullName().get(-1);
+    const ValidationError* outcome = m_resultCache->find(digest);
+    if (outcome != nullptr) {
+      NDN_LOG_DEBUG("Found cached outcome for data " << data.getName() << ": " << *outcome);
+      ValidationError error = *outcome;
+      if (error.getCode() == ValidationError::Code::NO_ERROR) {
+        successCb(data);
+      }
+      else {
+        failureCb(data, error);
+      }
+      return;
+    }
+
+    // the callbacks are invoked by the state, while the state is still alive
+    auto stateRef = make_shared<weak_ptr<ValidationState>>();
+    auto canCache = [this, anchorGeneration] {
+      return m_resultCache != nullptr && m_trustAnchors.getGeneration() == anchorGeneration;
+    };
+    state = make_shared<DataValidationState>(data,
+      [this, successCb, digest, stateRef, canCache] (const Data& data) {
+        auto state = stateRef->lock();
+        if (state != nullptr && canCache()) {
+          m_resultCache->insert(digest, ValidationError::Code::NO_ERROR, state->m_certificateExpiry);
+        }
+        successCb(data);
+      },
+      [this, failureCb, digest, stateRef, canCache] (const Data& data, const ValidationError& error) {
+        // only failures decided from the packet itself are remembered; a policy violation
+        // by a certificate retrieved from the network may not recur with another certificate
+        auto state = stateRef->lock();
+        if (state != nullptr && !state->m_hasRequestedCertificate &&
+            (error.getCode() == ValidationError::Code::POLICY_ERROR ||
+             error.getCode() == ValidationError::Code::INVALID_KEY_LOCATOR) &&
+            canCache()) {
+          m_resultCache->insert(digest, error);
+        }
+        failureCb(data, error);
+      });
+    *stateRef = state;
+  }
   NDN_LOG_DEBUG_DEPTH("Start validating data " << data.getName());
 
+  if (data.getSignature().getType() == tlv::SignatureSha256WithMerkleProof) {
+    return validateMerkleProof(data, state);
+  }
+
   m_policy->checkPolicy(data, state,
       [this] (const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state) {
       if (certRequest == nullptr) {
@@ -78,6 +173,46 @@ Validator::validate(const Data& data,
     });
 }
 
+void
+Validator::validateManifest(const Data& manifest,
+                            const DataValidationSuccessCallback& successCb,
+                            const DataValidationFailureCallback& failureCb)
+{
+  // the root is remembered no longer than the certificates that validate the manifest,
+  // whose expiry is known to the state, nor past a change of the trust anchors
+  refreshVerifiedManifests();
+  uint64_t anchorGeneration = m_manifestAnchorGeneration;
+  auto stateRef = make_shared<weak_ptr<ValidationState>>();
+  auto state = make_shared<DataValidationState>(manifest,
+    [this, successCb, stateRef, anchorGeneration] (const Data& validatedManifest) {
+      auto state = stateRef->lock();
+      refreshVerifiedManifests();
+      if (state != nullptr && m_manifestAnchorGeneration == anchorGeneration) {
+        time::nanoseconds lifetime = MAX_MANIFEST_LIFETIME;
+        if (validatedManifest.getFreshnessPeriod() > time::milliseconds::zero()) {
+          lifetime = std::min<time::nanoseconds>(lifetime, validatedManifest.getFreshnessPeriod());
+        }
+        addVerifiedManifest(validatedManifest,
+                            std::min(state->m_certificateExpiry, time::system_clock::now() + lifetime));
+      }
+      successCb(validatedManifest);
+    },
+    failureCb);
+  *stateRef = state;
+  NDN_LOG_DEBUG_DEPTH("Start validating manifest " << manifest.getName());
+
+  m_policy->checkPolicy(manifest, state,
+      [this] (const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state) {
+      if (certRequest == nullptr) {
+        state->bypassValidation();
+      }
+      else {
+        // need to fetch key and validate it
+        requestCertificate(certRequest, state);
+      }
+    });
+}
+
 void
 Validator::validate(const Interest& interest,
                     const InterestValidationSuccessCallback& successCb,
@@ -126,6 +261,8 @@ void
 Validator::requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
                               const shared_ptr<ValidationState>& state)
 {
+  state->m_hasRequestedCertificate = true;
+
   // TODO configurable check for the maximum number of steps
   if (state->getDepth() >= m_maxDepth) {
     state->fail({ValidationError::Code::EXCEEDED_DEPTH_LIMIT,
@@ -135,10 +272,22 @@ Validator::requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
 
   NDN_LOG_DEBUG_DEPTH("Retrieving " << certRequest->m_interest.getName());
 
-  auto cert = findTrustedCert(certRequest->m_interest);
+  auto cert = skipVerifiedCertificates(state);
+  if (cert == nullptr) {
+    cert = findTrustedCert(certRequest->m_interest);
+  }
   if (cert != nullptr) {
     NDN_LOG_TRACE_DEPTH("Found trusted certificate " << cert->getName());
 
+    state->m_certificateExpiry = getCertificateExpiry(*cert);
+    for (const Certificate& chainCert : state->m_certificateChain) {
+      state->m_certificateExpiry = std::min(state->m_certificateExpiry, getCertificateExpiry(chainCert));
+    }
+
+    if (m_verificationExecutor != nullptr) {
+      return verifyAsync(*cert, state);
+    }
+
     cert = state->verifyCertificateChain(*cert);
     if (cert != nullptr) {
       state->verifyOriginalPacket(*cert);
@@ -151,11 +300,147 @@ Validator::requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
     return;
   }
 
-  m_certFetcher->fetch(certRequest, state, [this] (const Certificate& cert, const shared_ptr<ValidationState>& state) {
+  m_certFetcher->fetch(certRequest, state,
+    [this, certRequest] (const Certificate& cert, const shared_ptr<ValidationState>& state) {
+      // another validation sharing the same fetch may have already verified the certificate
+      if (findTrustedCert(certRequest->m_interest) != nullptr) {
+        return requestCertificate(certRequest, state);
+      }
       validate(cert, state);
     });
 }
 
+const Certificate*
+Validator::skipVerifiedCertificates(const shared_ptr<ValidationState>& state)
+{
+  auto& chain = state->m_certificateChain;
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    const Certificate* verified = getVerifiedCertCache().find(it->getName());
+    if (verified != nullptr && *verified == *it) {
+      NDN_LOG_TRACE_DEPTH("Certificate " << it->getName() << " has already been verified");
+      chain.erase(chain.begin(), it.base());
+      return verified;
+    }
+  }
+  return nullptr;
+}
+
+void
+Validator::verifyAsync(const Certificate& trustedCert, const shared_ptr<ValidationState>& state)
+{
+  // decode the key on this thread, so that the stored certificate and the worker's copy share it
+  trustedCert.getParsedPublicKey();
+  // the trusted certificate may be evicted from the cache while the worker is verifying
+  auto cert = make_shared<Certificate>(trustedCert);
+  auto nValid = make_shared<size_t>(0);
+  auto isPacketValid = make_shared<bool>(false);
+
+  // the worker only reads the state, which is not accessed elsewhere until the completion
+  m_verificationExecutor->execute(
+    [state, cert, nValid, isPacketValid] {
+      *nValid = state->checkCertificateChain(*cert);
+      if (*nValid == state->m_certificateChain.size()) {
+        *isPacketValid = state->checkOriginalPacket(state->m_certificateChain.empty() ?
+                                                    *cert : state->m_certificateChain.back());
+      }
+    },
+    [this, state, cert, nValid, isPacketValid] {
+      if (state->finishCertificateChain(*cert, *nValid) != nullptr) {
+        state->finishOriginalPacket(*isPacketValid);
+      }
+      for (auto trustedCert = std::make_move_iterator(state->m_certificateChain.begin());
+           trustedCert != std::make_move_iterator(state->m_certificateChain.end());
+           ++trustedCert) {
+        cacheVerifiedCertificate(*trustedCert);
+      }
+    });
+}
+
+void
+Validator::validateMerkleProof(const Data& data, const shared_ptr<ValidationState>& state)
+{
+  const Signature& signature = data.getSignature();
+  if (!signature.hasKeyLocator() ||
+      signature.getKeyLocator().getType() != KeyLocator::KeyLocator_Name) {
+    return state->fail({ValidationError::Code::INVALID_KEY_LOCATOR,
+                        "Merkle proof does not name a manifest"});
+  }
+
+  const Name& manifestName = signature.getKeyLocator().getName();
+  refreshVerifiedManifests();
+  auto manifest = m_verifiedManifests.find(manifestName);
+  if (manifest == m_verifiedManifests.end() || manifest->expiry < time::system_clock::now()) {
+    return state->fail({ValidationError::Code::INVALID_KEY_LOCATOR, "Manifest `" +
+                        manifestName.toUri() + "` has not been validated"});
+  }
+
+  if (!verifyMerkleProof(data, manifest->root.data(), manifest->root.size())) {
+    return state->fail({ValidationError::Code::INVALID_SIGNATURE,
+                        "Invalid Merkle proof against manifest `" + manifestName.toUri() + "`"});
+  }
+  NDN_LOG_TRACE_DEPTH("Verified Merkle proof against manifest " << manifestName);
+
+  // The packet must conform to the policy as if it had been signed by the signer of the manifest.
+  shared_ptr<const Data> manifestData = manifest->manifest;
+  Data signedBySigner(data);
+  signedBySigner.setSignature(manifestData->getSignature());
+  m_policy->checkPolicy(signedBySigner, state,
+    [this, manifestData] (const shared_ptr<CertificateRequest>& certRequest,
+                          const shared_ptr<ValidationState>& state) {
+      if (certRequest == nullptr) {
+        return state->bypassValidation();
+      }
+
+      // The manifest signature has been verified with a certificate of the requested key.
+      // While such a certificate is trusted, nothing else needs to be verified.
+      if (findTrustedCert(certRequest->m_interest) != nullptr) {
+        NDN_LOG_TRACE_DEPTH("Signer of manifest " << manifestData->getName() << " is trusted");
+        return state->bypassValidation();
+      }
+
+      // Otherwise, the manifest is validated again, retrieving the certificates as usual
+      NDN_LOG_DEBUG_DEPTH("Signer of manifest " << manifestData->getName() << " is no longer trusted");
+      auto manifestState = make_shared<DataValidationState>(*manifestData,
+        [state] (const Data&) { state->bypassValidation(); },
+        [state] (const Data&, const ValidationError& error) { state->fail(error); });
+      requestCertificate(certRequest, manifestState);
+    });
+}
+
+void
+Validator::refreshVerifiedManifests()
+{
+  uint64_t anchorGeneration = m_trustAnchors.getGeneration();
+  if (anchorGeneration != m_manifestAnchorGeneration) {
+    NDN_LOG_DEBUG("Trust anchors changed, forgetting " << m_verifiedManifests.size() << " manifest(s)");
+    m_verifiedManifests.clear();
+    m_manifestAnchorGeneration = anchorGeneration;
+  }
+}
+
+void
+Validator::addVerifiedManifest(const Data& manifest, const time::system_clock::TimePoint& expiry)
+{
+  auto now = time::system_clock::now();
+  auto& manifestsByExpiry = m_verifiedManifests.get<1>();
+  while (!manifestsByExpiry.empty() && manifestsByExpiry.begin()->expiry < now) {
+    manifestsByExpiry.erase(manifestsByExpiry.begin());
+  }
+  if (expiry < now) {
+    return;
+  }
+
+  m_verifiedManifests.erase(manifest.getName());
+  if (m_verifiedManifests.size() >= MAX_VERIFIED_MANIFESTS) {
+    NDN_LOG_DEBUG("Forgetting manifest " << manifestsByExpiry.begin()->name);
+    manifestsByExpiry.erase(manifestsByExpiry.begin());
+  }
+
+  const Block& content = manifest.getContent();
+  m_verifiedManifests.insert({manifest.getName(), Buffer(content.value(), content.value_size()),
+                              make_shared<Data>(manifest), expiry});
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Trust anchor management
 ////////////////////////////////////////////////////////////////////////
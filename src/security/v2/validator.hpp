@@ -27,7 +27,14 @@
 #include "certificate-storage.hpp"
 #include "validation-callback.hpp"
 #include "validation-policy.hpp"
+#include "validation-result-cache.hpp"
 #include "validation-state.hpp"
+#include "verification-executor.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/member.hpp>
 
 namespace ndn {
 
@@ -83,9 +90,64 @@ public:
   size_t
   getMaxDepth() const;
 
+  /**
+   * @brief Offload signature verification to @p executor
+   *
+   * Once the certificate chain of a packet terminates at a trusted certificate, the
+   * signatures of the chain and of the packet are verified on a worker thread of
+   * @p executor.  Policy checks, certificate retrieval, and the success and failure
+   * callbacks remain on the thread that runs the io_service of @p executor, which must be
+   * the thread that uses the validator.
+   *
+   * @param executor The verification executor, or nullptr to verify signatures synchronously
+   *                 on the calling thread (the default)
+   * @note Validations whose signature verification is pending when the executor is replaced
+   *       or the validator is destroyed fail with IMPLEMENTATION_ERROR.
+   */
+  void
+  setVerificationExecutor(unique_ptr<VerificationExecutor> executor);
+
+  /**
+   * @brief Remember outcomes of Data validation in @p cache
+   *
+   * A Data packet whose implicit digest is found in @p cache is accepted or rejected without
+   * running the policy or verifying any signature.  Successful outcomes are remembered until
+   * the earliest NotAfter time of the certificates used to validate the packet.  Of the
+   * failures, only POLICY_ERROR and INVALID_KEY_LOCATOR that the policy decides from the
+   * packet alone, before any certificate is requested, are remembered; the other failures
+   * may be caused by transient conditions or by certificates retrieved from the network.
+   *
+   * The cache is cleared when a trust anchor is added or removed, including by the refresh
+   * of a dynamic anchor group.  The policy cannot be replaced; if the decisions of the
+   * policy change, the cache should be cleared with getValidationResultCache()->clear().
+   *
+   * Interest validation is never cached, as signed Interests are expected to be unique.
+   * Data signed with SignatureSha256WithMerkleProof bypasses the cache.
+   *
+   * @param cache The validation result cache, or nullptr to disable caching (the default)
+   */
+  void
+  setValidationResultCache(unique_ptr<ValidationResultCache> cache);
+
+  /**
+   * @return The validation result cache, or nullptr if caching is disabled
+   */
+  ValidationResultCache*
+  getValidationResultCache() const;
+
   /**
    * @brief Asynchronously validate @p data
    *
+   * If @p data is signed with SignatureSha256WithMerkleProof, it is valid only if the
+   * manifest named by its KeyLocator has been validated with validateManifest and its digest
+   * path leads to the Merkle tree root carried by that manifest.
+   *
+   * @pre For Data signed with SignatureSha256WithMerkleProof, the application must have
+   *      validated the manifest with validateManifest, and that validation must have succeeded
+   *      before @p data is validated.  The validator does not fetch the manifest: if it is not
+   *      remembered, e.g., because it has not been validated yet or has expired, the validation
+   *      fails with ValidationError::INVALID_KEY_LOCATOR and no Interest is sent.
+   *
    * @note @p successCb and @p failureCb must not be nullptr
    */
   void
@@ -93,6 +155,27 @@ public:
            const DataValidationSuccessCallback& successCb,
            const DataValidationFailureCallback& failureCb);
 
+  /**
+   * @brief Asynchronously validate @p manifest, and remember its Merkle tree root on success
+   *
+   * The root is remembered for the FreshnessPeriod of @p manifest, or MAX_MANIFEST_LIFETIME
+   * if it is unset or longer, but no later than the earliest NotAfter time of the certificates
+   * used to validate it, and only as long as the trust anchors stay unchanged.  Meanwhile, the Data packets
+   * signed by KeyChain::signBatch together with @p manifest are validated without
+   * signature verification or certificate retrieval: each packet must carry a valid Merkle
+   * proof, and must be acceptable to the policy as if it had been signed by the signer of
+   * @p manifest.  If the policy requests the certificate of that signer and no trusted
+   * certificate of its key is known anymore, @p manifest is validated again as part of the
+   * validation of the packet.  At most MAX_VERIFIED_MANIFESTS roots are remembered; when this limit is
+   * reached, the root that would expire first is forgotten.
+   *
+   * @note @p successCb and @p failureCb must not be nullptr
+   */
+  void
+  validateManifest(const Data& manifest,
+                   const DataValidationSuccessCallback& successCb,
+                   const DataValidationFailureCallback& failureCb);
+
   /**
    * @brief Asynchronously validate @p interest
    *
@@ -103,6 +186,17 @@ public:
            const InterestValidationSuccessCallback& successCb,
            const InterestValidationFailureCallback& failureCb);
 
+public:
+  /**
+   * @brief the maximum number of manifests whose Merkle tree roots are remembered
+   */
+  static const size_t MAX_VERIFIED_MANIFESTS;
+
+  /**
+   * @brief the maximum time that the Merkle tree root of a manifest is remembered
+   */
+  static const time::nanoseconds MAX_MANIFEST_LIFETIME;
+
 public: // anchor management
   /**
    * @brief load static trust anchor.
@@ -158,10 +252,83 @@ private: // Common validator operations
   requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
                      const shared_ptr<ValidationState>& state);
 
+  /**
+   * @brief Remove the certificates of the chain that have already been verified
+   *
+   * Validations that share the retrieval of a certificate build the same chain.  The first of
+   * them to reach a trusted certificate verifies the chain and caches it, and the others need
+   * to verify only the certificates below the last cached one.
+   *
+   * @return The last certificate of the chain that is in the verified certificate cache, which
+   *         signs the rest of the chain; nullptr if there is none, in which case the chain is
+   *         not modified.
+   */
+  const Certificate*
+  skipVerifiedCertificates(const shared_ptr<ValidationState>& state);
+
+  /**
+   * @brief Verify signatures of the certificate chain and the original packet on the
+   *        verification executor, and finish the validation when done
+   *
+   * @param trustedCert The trusted certificate at which the certificate chain terminates
+   * @param state       The current validation state.
+   */
+  void
+  verifyAsync(const Certificate& trustedCert, const shared_ptr<ValidationState>& state);
+
+  /**
+   * @brief Validate @p data signed with SignatureSha256WithMerkleProof against the root of
+   *        a validated manifest
+   *
+   * Fails with INVALID_KEY_LOCATOR if the manifest has not been validated by validateManifest.
+   */
+  void
+  validateMerkleProof(const Data& data, const shared_ptr<ValidationState>& state);
+
+  /**
+   * @brief Remember the Merkle tree root carried by @p manifest, which has been validated
+   */
+  void
+  addVerifiedManifest(const Data& manifest, const time::system_clock::TimePoint& expiry);
+
+  /**
+   * @brief Forget all remembered manifests if the trust anchors have changed since they
+   *        were validated
+   */
+  void
+  refreshVerifiedManifests();
+
 private:
+  struct VerifiedManifest
+  {
+    Name name;
+    Buffer root;
+    shared_ptr<const Data> manifest; ///< the manifest, validated again if its signer is no longer trusted
+    time::system_clock::TimePoint expiry;
+  };
+
+  typedef boost::multi_index::multi_index_container<
+    VerifiedManifest,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<
+        boost::multi_index::member<VerifiedManifest, Name, &VerifiedManifest::name>,
+        std::hash<Name>
+      >,
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::member<VerifiedManifest, time::system_clock::TimePoint,
+                                   &VerifiedManifest::expiry>
+      >
+    >
+  > VerifiedManifestIndex;
+
   unique_ptr<ValidationPolicy> m_policy;
   unique_ptr<CertificateFetcher> m_certFetcher;
   size_t m_maxDepth;
+  VerifiedManifestIndex m_verifiedManifests;
+  uint64_t m_manifestAnchorGeneration; ///< generation of trust anchors for m_verifiedManifests
+  unique_ptr<VerificationExecutor> m_verificationExecutor;
+  unique_ptr<ValidationResultCache> m_resultCache;
+  uint64_t m_resultCacheAnchorGeneration; ///< generation of trust anchors for m_resultCache
 };
 
 } // namespace v2
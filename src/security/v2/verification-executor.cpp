@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "verification-executor.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+VerificationExecutor::VerificationExecutor(boost::asio::io_service& ioService, size_t nThreads)
+  : m_ioService(ioService)
+  , m_work(new boost::asio::io_service::work(m_workerService))
+  , m_token(make_shared<int>())
+{
+  if (nThreads == 0) {
+    nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  m_threads.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_threads.emplace_back([this] { m_workerService.run(); });
+  }
+}
+
+VerificationExecutor::~VerificationExecutor()
+{
+  m_work.reset();
+  m_workerService.stop();
+  for (std::thread& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void
+VerificationExecutor::execute(function<void()> task, function<void()> completion)
+{
+  // keeps m_ioService running until the completion has been posted
+  auto work = make_shared<boost::asio::io_service::work>(m_ioService);
+  weak_ptr<int> token = m_token;
+
+  m_workerService.post([this, task, completion, work, token] () mutable {
+    task();
+    // the completion is moved rather than copied, so that whatever it holds is released
+    // on the io_service thread
+    task = nullptr;
+    m_ioService.post(std::bind([] (const weak_ptr<int>& token, const function<void()>& completion) {
+                                 if (!token.expired()) {
+                                   completion();
+                                 }
+                               },
+                               token, std::move(completion)));
+  });
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_SECURITY_V2_VERIFICATION_EXECUTOR_HPP
+#define NDN_SECURITY_V2_VERIFICATION_EXECUTOR_HPP
+
+#include "../../common.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief A pool of worker threads that verify signatures on behalf of a Validator
+ *
+ * Each task runs on one of the worker threads; its completion is then posted to the
+ * io_service on which the validator runs, so that the validation state and the success and
+ * failure callbacks are only accessed from that thread.  While tasks are outstanding, the
+ * io_service is kept from running out of work.
+ *
+ * @sa Validator::setVerificationExecutor
+ */
+class VerificationExecutor : noncopyable
+{
+public:
+  /**
+   * @brief Start @p nThreads worker threads
+   *
+   * @param ioService The io_service on which completions are invoked
+   * @param nThreads The number of worker threads; 0 selects the number of hardware threads
+   */
+  VerificationExecutor(boost::asio::io_service& ioService, size_t nThreads = 0);
+
+  /**
+   * @brief Stop and join the worker threads
+   *
+   * Tasks that have not started are discarded, and completions that have not been invoked
+   * are dropped.
+   *
+   * @warning must not be invoked from a worker thread
+   */
+  ~VerificationExecutor();
+
+  size_t
+  getNThreads() const
+  {
+    return m_threads.size();
+  }
+
+  /**
+   * @brief Run @p task on a worker thread, and then @p completion on the io_service
+   *
+   * @p task must not access any object that the io_service thread may modify concurrently.
+   */
+  void
+  execute(function<void()> task, function<void()> completion);
+
+private:
+  boost::asio::io_service& m_ioService;
+  boost::asio::io_service m_workerService;
+  unique_ptr<boost::asio::io_service::work> m_work;
+  std::vector<std::thread> m_threads;
+
+  /// completions posted to m_ioService are invoked only while this is alive
+  shared_ptr<int> m_token;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_VERIFICATION_EXECUTOR_HPP
@@ -119,8 +119,6 @@ ValidatorConfig::load(const security::conf::ConfigSection& configSection,
 {
   BOOST_ASSERT(!filename.empty());
 
-  reset();
-
   if (configSection.begin() == configSection.end()) {
     std::string msg = "Error processing configuration file";
     msg += ": ";
@@ -129,25 +127,53 @@ ValidatorConfig::load(const security::conf::ConfigSection& configSection,
     BOOST_THROW_EXCEPTION(security::conf::Error(msg));
   }
 
-  for (security::conf::ConfigSection::const_iterator i = configSection.begin();
-       i != configSection.end(); ++i) {
-    const std::string& sectionName = i->first;
-    const security::conf::ConfigSection& section = i->second;
+  // keep the current configuration until the new one has been loaded completely
+  bool oldShouldValidate = m_shouldValidate;
+  InterestRuleList oldInterestRules;
+  DataRuleList oldDataRules;
+  AnchorList oldAnchors;
+  TrustAnchorContainer oldStaticContainer = m_staticContainer;
+  DynamicContainers oldDynamicContainers;
+  oldInterestRules.swap(m_interestRules);
+  oldDataRules.swap(m_dataRules);
+  oldAnchors.swap(m_anchors);
+  oldDynamicContainers.swap(m_dynamicContainers);
+  m_staticContainer = TrustAnchorContainer();
 
-    if (boost::iequals(sectionName, "rule")) {
-      onConfigRule(section, filename);
-    }
-    else if (boost::iequals(sectionName, "trust-anchor")) {
-      onConfigTrustAnchor(section, filename);
-    }
-    else {
-      std::string msg = "Error processing configuration file";
-      msg += " ";
-      msg += filename;
-      msg += " unrecognized section: " + sectionName;
-      BOOST_THROW_EXCEPTION(security::conf::Error(msg));
+  try {
+    for (security::conf::ConfigSection::const_iterator i = configSection.begin();
+         i != configSection.end(); ++i) {
+      const std::string& sectionName = i->first;
+      const security::conf::ConfigSection& section = i->second;
+
+      if (boost::iequals(sectionName, "rule")) {
+        onConfigRule(section, filename);
+      }
+      else if (boost::iequals(sectionName, "trust-anchor")) {
+        onConfigTrustAnchor(section, filename);
+      }
+      else {
+        std::string msg = "Error processing configuration file";
+        msg += " ";
+        msg += filename;
+        msg += " unrecognized section: " + sectionName;
+        BOOST_THROW_EXCEPTION(security::conf::Error(msg));
+      }
     }
   }
+  catch (...) {
+    m_shouldValidate = oldShouldValidate;
+    m_interestRules.swap(oldInterestRules);
+    m_dataRules.swap(oldDataRules);
+    m_anchors.swap(oldAnchors);
+    m_dynamicContainers.swap(oldDynamicContainers);
+    m_staticContainer = oldStaticContainer;
+    throw;
+  }
+
+  if (m_certificateCache != nullptr)
+    m_certificateCache->reset();
+  compileRules();
 }
 
 void
@@ -231,6 +257,18 @@ ValidatorConfig::onConfigRule(const security::conf::ConfigSection& configSection
   }
 }
 
+void
+ValidatorConfig::compileRules()
+{
+  m_dataRuleIndex.clear();
+  for (const auto& rule : m_dataRules)
+    m_dataRuleIndex.insert(rule);
+
+  m_interestRuleIndex.clear();
+  for (const auto& rule : m_interestRules)
+    m_interestRuleIndex.insert(rule);
+}
+
 void
 ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& configSection,
                                      const std::string& filename)
@@ -355,6 +393,8 @@ ValidatorConfig::reset()
     m_certificateCache->reset();
   m_interestRules.clear();
   m_dataRules.clear();
+  m_interestRuleIndex.clear();
+  m_dataRuleIndex.clear();
 
   m_anchors.clear();
 
@@ -449,20 +489,12 @@ ValidatorConfig::checkPolicy(const Data& data,
   if (!m_shouldValidate)
     return onValidated(data.shared_from_this());
 
-  bool isMatched = false;
-  int8_t checkResult = -1;
-
-  for (const auto& dataRule : m_dataRules) {
-    if (dataRule->match(data)) {
-      isMatched = true;
-      checkResult = dataRule->check(data, onValidated, onValidationFailed);
-      break;
-    }
-  }
-
-  if (!isMatched)
+  shared_ptr<DataRule> dataRule = m_dataRuleIndex.findFirstMatch(data);
+  if (dataRule == nullptr)
     return onValidationFailed(data.shared_from_this(), "No rule matched!");
 
+  int8_t checkResult = dataRule->check(data, onValidated, onValidationFailed);
+
   if (checkResult == 0) {
     const Signature& signature = data.getSignature();
     checkSignature(data, signature, nSteps,
@@ -501,23 +533,15 @@ ValidatorConfig::checkPolicy(const Interest& interest,
 
     Name keyName = v1::IdentityCertificate::certificateNameToPublicKeyName(keyLocator.getName());
 
-    bool isMatched = false;
-    int8_t checkResult = -1;
-
-    for (const auto& interestRule : m_interestRules) {
-      if (interestRule->match(interest)) {
-        isMatched = true;
-        checkResult = interestRule->check(interest,
-                                          bind(&ValidatorConfig::checkTimestamp, this, _1,
-                                               keyName, onValidated, onValidationFailed),
-                                          onValidationFailed);
-        break;
-      }
-    }
-
-    if (!isMatched)
+    shared_ptr<InterestRule> interestRule = m_interestRuleIndex.findFirstMatch(interest);
+    if (interestRule == nullptr)
       return onValidationFailed(interest.shared_from_this(), "No rule matched!");
 
+    int8_t checkResult = interestRule->check(interest,
+                                             bind(&ValidatorConfig::checkTimestamp, this, _1,
+                                                  keyName, onValidated, onValidationFailed),
+                                             onValidationFailed);
+
     if (checkResult == 0) {
       checkSignature<Interest, OnInterestValidated, OnInterestValidationFailed>
         (interest, signature, nSteps,
@@ -24,7 +24,7 @@
 
 #include "validator.hpp"
 #include "certificate-cache.hpp"
-#include "conf/rule.hpp"
+#include "conf/rule-index.hpp"
 #include "conf/common.hpp"
 
 namespace ndn {
@@ -76,6 +76,13 @@ public:
   void
   load(std::istream& input, const std::string& filename);
 
+  /**
+   * @brief Load rules and trust anchors from @p configSection
+   *
+   * The rules are compiled into a name-indexed rule set.  The new configuration replaces the
+   * current one only when it has been loaded completely; if an error is thrown, the current
+   * rules and trust anchors are kept.
+   */
   void
   load(const security::conf::ConfigSection& configSection,
        const std::string& filename);
@@ -135,6 +142,12 @@ private:
   onConfigRule(const security::conf::ConfigSection& section,
                const std::string& filename);
 
+  /**
+   * @brief Rebuild the rule indexes from m_dataRules and m_interestRules
+   */
+  void
+  compileRules();
+
   void
   onConfigTrustAnchor(const security::conf::ConfigSection& section,
                       const std::string& filename);
@@ -243,6 +256,8 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   InterestRuleList m_interestRules;
   DataRuleList m_dataRules;
+  security::conf::RuleIndex<Interest> m_interestRuleIndex;
+  security::conf::RuleIndex<Data> m_dataRuleIndex;
 
   AnchorList m_anchors;
   TrustAnchorContainer m_staticContainer;
@@ -25,9 +25,9 @@
 #include "interest.hpp"
 #include "encoding/buffer-stream.hpp"
 #include "security/pib/key.hpp"
-#include "security/pib/key.hpp"
 #include "security/transform.hpp"
 #include "security/v2/certificate.hpp"
+#include "security/detail/merkle-tree.hpp"
 #include "security/detail/openssl.hpp"
 
 namespace ndn {
@@ -175,13 +175,56 @@ verifySignature(const Interest& interest, const uint8_t* key, size_t keyLen)
 bool
 verifySignature(const Data& data, const v2::Certificate& cert)
 {
-  return verifySignature(parse(data), cert.getContent().value(), cert.getContent().value_size());
+  auto key = cert.getParsedPublicKey();
+  if (key == nullptr)
+    return false;
+  return verifySignature(parse(data), *key);
 }
 
 bool
 verifySignature(const Interest& interest, const v2::Certificate& cert)
 {
-  return verifySignature(parse(interest), cert.getContent().value(), cert.getContent().value_size());
+  auto key = cert.getParsedPublicKey();
+  if (key == nullptr)
+    return false;
+  return verifySignature(parse(interest), *key);
+}
+
+bool
+verifyMerkleProof(const Data& data, const uint8_t* root, size_t rootLen)
+{
+  if (data.getSignature().getType() != tlv::SignatureSha256WithMerkleProof)
+    return false;
+
+  bool isParsable = false;
+  const uint8_t* buf = nullptr;
+  size_t bufLen = 0;
+  const uint8_t* proof = nullptr;
+  size_t proofLen = 0;
+
+  std::tie(isParsable, buf, bufLen, proof, proofLen) = parse(data);
+
+  if (isParsable)
+    return detail::MerkleTree::verifyProof(detail::MerkleTree::hashLeaf(buf, bufLen),
+                                           proof, proofLen, root, rootLen);
+  else
+    return false;
+}
+
+bool
+verifyMerkleProof(const Data& data, const Data& manifest)
+{
+  try {
+    if (!data.getSignature().hasKeyLocator() ||
+        data.getSignature().getKeyLocator().getType() != KeyLocator::KeyLocator_Name ||
+        data.getSignature().getKeyLocator().getName() != manifest.getName())
+      return false;
+  }
+  catch (const tlv::Error&) {
+    return false;
+  }
+
+  return verifyMerkleProof(data, manifest.getContent().value(), manifest.getContent().value_size());
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -112,6 +112,25 @@ verifySignature(const Data& data, const v2::Certificate& cert);
 bool
 verifySignature(const Interest& interest, const v2::Certificate& cert);
 
+/**
+ * @brief Verify @p data signed with a manifest by KeyChain::signBatch against Merkle tree @p root.
+ *
+ * Checks that the digest path in the SignatureValue of @p data leads to @p root.
+ */
+bool
+verifyMerkleProof(const Data& data, const uint8_t* root, size_t rootLen);
+
+/**
+ * @brief Verify @p data signed with a manifest by KeyChain::signBatch against @p manifest.
+ *
+ * Checks that the KeyLocator of @p data names @p manifest and that the digest path in the
+ * SignatureValue of @p data leads to the Merkle tree root carried by @p manifest.
+ *
+ * @note The signature of @p manifest itself is not verified.
+ */
+bool
+verifyMerkleProof(const Data& data, const Data& manifest);
+
 //////////////////////////////////////////////////////////////////
 
 /**
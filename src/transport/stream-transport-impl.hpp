@@ -25,6 +25,7 @@
 #include "transport.hpp"
 
 #include <boost/asio.hpp>
+#include <atomic>
 #include <list>
 
 namespace ndn {
@@ -42,10 +43,38 @@ public:
   typedef std::list<Block> BlockSequence;
   typedef std::list<BlockSequence> TransmissionQueue;
 
+  /** \brief size of a receive buffer chunk
+   *
+   *  Received packets are handed to the Face as Blocks that share the chunk they were read
+   *  into, so a chunk must be able to hold at least one packet of maximum size.
+   */
+  static const size_t RECEIVE_CHUNK_SIZE = 4 * MAX_NDN_PACKET_SIZE;
+
+  /** \brief minimum size of a packet that is handed to the Face sharing its chunk
+   *
+   *  Only packets of at least MIN_SHARED_PACKET_SIZE (2200 octets) are received without a
+   *  copy.  Smaller packets, which include nearly every Interest and most Data, are copied
+   *  into a slab of MIN_SHARED_PACKET_SIZE octets shared by consecutive small packets, and the
+   *  slab is rewritten in place once none of them is referenced anymore.  A Block retained by
+   *  the application keeps its whole chunk or slab alive, so this limit bounds a retained
+   *  packet to pinning at most 16 times its size, or MIN_SHARED_PACKET_SIZE octets for a small
+   *  packet: a packet of MIN_SHARED_PACKET_SIZE kept by the application, e.g., in
+   *  InMemoryStorage, holds on to a whole RECEIVE_CHUNK_SIZE chunk (35200 octets) until it is
+   *  released.  An application that retains many received packets for a long time should
+   *  store copies of them, e.g., Block(block.wire(), block.size()).
+   */
+  static const size_t MIN_SHARED_PACKET_SIZE = RECEIVE_CHUNK_SIZE / 16;
+
+  /** \brief maximum number of retired chunks kept for reuse
+   */
+  static const size_t MAX_POOLED_CHUNKS = 16;
+
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
     , m_socket(ioService)
     , m_inputBufferSize(0)
+    , m_slabSize(0)
+    , m_nBatchedSequences(0)
     , m_isConnecting(false)
     , m_connectTimer(ioService)
   {
@@ -80,6 +109,8 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isReceiving = false;
     m_transmissionQueue.clear();
+    m_writeBuffers.clear();
+    m_nBatchedSequences = 0;
   }
 
   void
@@ -169,16 +200,49 @@ protected:
     // next write will be scheduled either in connectHandler or in asyncWriteHandler
   }
 
+  /** \brief gather packets from the front of the transmission queue into one write operation
+   *
+   *  The batch is limited by BaseTransport's write batch limits, but always contains at least
+   *  one packet.  The gathered packets stay in the queue until they are completely written.
+   */
   void
   asyncWrite()
   {
     BOOST_ASSERT(!m_transmissionQueue.empty());
-    boost::asio::async_write(m_socket, m_transmissionQueue.front(),
-      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, m_transmissionQueue.begin()));
+
+    m_writeBuffers.clear();
+    m_nBatchedSequences = 0;
+    size_t nBatchedBytes = 0;
+    for (const BlockSequence& sequence : m_transmissionQueue) {
+      size_t nBytes = 0;
+      for (const Block& block : sequence) {
+        nBytes += block.size();
+      }
+
+      if (m_nBatchedSequences > 0 &&
+          (nBatchedBytes + nBytes > m_transport.m_maxWriteBatchBytes ||
+           m_writeBuffers.size() + sequence.size() > m_transport.m_maxWriteBatchBuffers)) {
+        break;
+      }
+
+      m_writeBuffers.insert(m_writeBuffers.end(), sequence.begin(), sequence.end());
+      nBatchedBytes += nBytes;
+      ++m_nBatchedSequences;
+    }
+
+    asyncWriteSome();
   }
 
   void
-  handleAsyncWrite(const boost::system::error_code& error, TransmissionQueue::iterator queueItem)
+  asyncWriteSome()
+  {
+    ++m_transport.m_writeCounters.nWriteOps;
+    m_socket.async_write_some(m_writeBuffers,
+      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, _2));
+  }
+
+  void
+  handleAsyncWrite(const boost::system::error_code& error, size_t nBytesWritten)
   {
     if (error) {
       if (error == boost::system::errc::operation_canceled) {
@@ -194,7 +258,26 @@ protected:
       return; // queue has been already cleared
     }
 
-    m_transmissionQueue.erase(queueItem);
+    m_transport.m_writeCounters.nOutBytes += nBytesWritten;
+
+    // drop the buffers that have been completely written, and continue with the rest
+    auto buffer = m_writeBuffers.begin();
+    while (buffer != m_writeBuffers.end() && nBytesWritten >= boost::asio::buffer_size(*buffer)) {
+      nBytesWritten -= boost::asio::buffer_size(*buffer);
+      ++buffer;
+    }
+    m_writeBuffers.erase(m_writeBuffers.begin(), buffer);
+    if (!m_writeBuffers.empty()) {
+      m_writeBuffers.front() = m_writeBuffers.front() + nBytesWritten;
+      asyncWriteSome();
+      return;
+    }
+
+    m_transport.m_writeCounters.nOutPackets += m_nBatchedSequences;
+    auto batchEnd = m_transmissionQueue.begin();
+    std::advance(batchEnd, m_nBatchedSequences);
+    m_transmissionQueue.erase(m_transmissionQueue.begin(), batchEnd);
+    m_nBatchedSequences = 0;
 
     if (!m_transmissionQueue.empty()) {
       asyncWrite();
@@ -204,8 +287,12 @@ protected:
   void
   asyncReceive()
   {
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
+    if (m_inputBuffer == nullptr) {
+      m_inputBuffer = acquireChunk();
+    }
+
+    m_socket.async_receive(boost::asio::buffer(m_inputBuffer->get() + m_inputBufferSize,
+                                               RECEIVE_CHUNK_SIZE - m_inputBufferSize), 0,
                            bind(&Impl::handleAsyncReceive, this->shared_from_this(), _1, _2));
   }
 
@@ -227,7 +314,7 @@ protected:
 
     std::size_t offset = 0;
     bool hasProcessedSome = processAllReceived(m_inputBuffer, offset, m_inputBufferSize);
-    if (!hasProcessedSome && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0) {
+    if (!hasProcessedSome && m_inputBufferSize >= MAX_NDN_PACKET_SIZE && offset == 0) {
       m_transport.close();
       BOOST_THROW_EXCEPTION(Transport::Error(boost::system::error_code(),
                                              "input buffer full, but a valid TLV cannot be "
@@ -235,8 +322,24 @@ protected:
     }
 
     if (offset > 0) {
+      // Blocks handed to the Face may still reference the current chunk, in which case the
+      // remaining partial packet (if any) is moved into another chunk instead of overwriting
+      // the bytes in place
+      bool isChunkShared = m_inputBuffer.use_count() > 1;
+      BufferPtr chunk = m_inputBuffer;
+      if (isChunkShared) {
+        m_inputBuffer = acquireChunk();
+        retireChunk(chunk);
+      }
+      else {
+        // use_count() is a relaxed load; order the writes below after the last reads made
+        // through Blocks released on other threads
+        std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
       if (offset != m_inputBufferSize) {
-        std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize, m_inputBuffer);
+        std::copy(chunk->begin() + offset, chunk->begin() + m_inputBufferSize,
+                  m_inputBuffer->begin());
         m_inputBufferSize -= offset;
       }
       else {
@@ -248,34 +351,122 @@ protected:
   }
 
   bool
-  processAllReceived(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
+  processAllReceived(const BufferPtr& buffer, size_t& offset, size_t nBytesAvailable)
   {
     while (offset < nBytesAvailable) {
-      bool isOk = false;
-      Block element;
-      std::tie(isOk, element) = Block::fromBuffer(buffer + offset, nBytesAvailable - offset);
-      if (!isOk)
+      Buffer::const_iterator begin = buffer->begin() + offset;
+      Buffer::const_iterator valueBegin = begin;
+      Buffer::const_iterator end = buffer->begin() + nBytesAvailable;
+
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (!tlv::readType(valueBegin, end, type) ||
+          !tlv::readVarNumber(valueBegin, end, length)) {
         return false;
+      }
 
-      m_transport.receive(element);
-      offset += element.size();
+      size_t headerSize = valueBegin - begin;
+      if (length > MAX_NDN_PACKET_SIZE - headerSize) {
+        m_transport.close();
+        BOOST_THROW_EXCEPTION(Transport::Error(boost::system::error_code(),
+                                               "received packet exceeds MAX_NDN_PACKET_SIZE"));
+      }
+      if (length > static_cast<uint64_t>(end - valueBegin)) {
+        return false;
+      }
+
+      size_t elementSize = headerSize + length;
+      offset += elementSize;
+      if (elementSize >= MIN_SHARED_PACKET_SIZE) {
+        // the Block shares the chunk, no bytes are copied
+        m_transport.receive(Block(buffer, type, begin, valueBegin + length,
+                                  valueBegin, valueBegin + length));
+      }
+      else {
+        prepareSlab(elementSize);
+        Buffer::const_iterator slabBegin = m_slab->begin() + m_slabSize;
+        std::copy(begin, valueBegin + length, m_slab->begin() + m_slabSize);
+        m_slabSize += elementSize;
+        m_transport.receive(Block(m_slab, type, slabBegin, slabBegin + elementSize,
+                                  slabBegin + headerSize, slabBegin + elementSize));
+      }
     }
     return true;
   }
 
+  /** \brief make room for a small packet of \p nBytes octets in the slab
+   */
+  void
+  prepareSlab(size_t nBytes)
+  {
+    if (m_slab != nullptr && m_slabSize + nBytes <= MIN_SHARED_PACKET_SIZE) {
+      return;
+    }
+
+    if (m_slab != nullptr && m_slab.use_count() == 1) {
+      // see handleAsyncReceive
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    else {
+      m_slab = make_shared<Buffer>(static_cast<size_t>(MIN_SHARED_PACKET_SIZE));
+    }
+    m_slabSize = 0;
+  }
+
+  /** \brief obtain a chunk that is not referenced by any Block
+   */
+  BufferPtr
+  acquireChunk()
+  {
+    for (auto it = m_chunkPool.begin(); it != m_chunkPool.end(); ++it) {
+      if (it->use_count() == 1) {
+        // see handleAsyncReceive
+        std::atomic_thread_fence(std::memory_order_acquire);
+        BufferPtr chunk = *it;
+        m_chunkPool.erase(it);
+        return chunk;
+      }
+    }
+    return make_shared<Buffer>(static_cast<size_t>(RECEIVE_CHUNK_SIZE));
+  }
+
+  /** \brief keep a chunk for reuse after all Blocks referencing it are released
+   */
+  void
+  retireChunk(const BufferPtr& chunk)
+  {
+    if (m_chunkPool.size() < MAX_POOLED_CHUNKS) {
+      m_chunkPool.push_back(chunk);
+    }
+  }
+
 protected:
   BaseTransport& m_transport;
 
   typename Protocol::socket m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
+  BufferPtr m_inputBuffer;
   size_t m_inputBufferSize;
+  std::vector<BufferPtr> m_chunkPool;
+  BufferPtr m_slab; ///< buffer shared by received packets smaller than MIN_SHARED_PACKET_SIZE
+  size_t m_slabSize;
 
   TransmissionQueue m_transmissionQueue;
+  std::vector<boost::asio::const_buffer> m_writeBuffers; ///< buffers of the write in progress
+  size_t m_nBatchedSequences; ///< number of queued sequences covered by m_writeBuffers
   bool m_isConnecting;
 
   boost::asio::deadline_timer m_connectTimer;
 };
 
+template<typename BaseTransport, typename Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::RECEIVE_CHUNK_SIZE;
+
+template<typename BaseTransport, typename Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MIN_SHARED_PACKET_SIZE;
+
+template<typename BaseTransport, typename Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_POOLED_CHUNKS;
+
 } // namespace ndn
 
 #endif // NDN_TRANSPORT_STREAM_TRANSPORT_IMPL_HPP
@@ -23,6 +23,9 @@
 
 namespace ndn {
 
+const size_t Transport::DEFAULT_MAX_WRITE_BATCH_BYTES = 65536;
+const size_t Transport::DEFAULT_MAX_WRITE_BATCH_BUFFERS = 64;
+
 Transport::Error::Error(const boost::system::error_code& code, const std::string& msg)
   : std::runtime_error(msg + (code.value() ? " (" + code.category().message(code.value()) + ")" : ""))
 {
@@ -37,6 +40,8 @@ Transport::Transport()
   : m_ioService(nullptr)
   , m_isConnected(false)
   , m_isReceiving(false)
+  , m_maxWriteBatchBytes(DEFAULT_MAX_WRITE_BATCH_BYTES)
+  , m_maxWriteBatchBuffers(DEFAULT_MAX_WRITE_BATCH_BUFFERS)
 {
 }
 
@@ -50,4 +55,13 @@ Transport::connect(boost::asio::io_service& ioService,
   m_receiveCallback = receiveCallback;
 }
 
+void
+Transport::setWriteBatchLimits(size_t maxBytes, size_t maxBuffers)
+{
+  BOOST_ASSERT(maxBuffers > 0);
+
+  m_maxWriteBatchBytes = maxBytes;
+  m_maxWriteBatchBuffers = maxBuffers;
+}
+
 } // namespace ndn
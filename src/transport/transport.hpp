@@ -52,6 +52,36 @@ public:
   typedef function<void(const Block& wire)> ReceiveCallback;
   typedef function<void()> ErrorCallback;
 
+  /** \brief counters of write operations on the underlying socket
+   *
+   *  Stream-oriented transports gather several queued packets into one scatter/gather
+   *  write operation; these counters show how effective that is.
+   */
+  class WriteCounters
+  {
+  public:
+    /** \return average number of packets written per write operation
+     */
+    double
+    getAverageBatchSize() const
+    {
+      return nWriteOps == 0 ? 0.0 : static_cast<double>(nOutPackets) / nWriteOps;
+    }
+
+  public:
+    uint64_t nWriteOps = 0;   ///< number of write operations (system calls) issued on the socket
+    uint64_t nOutBytes = 0;   ///< number of bytes written
+    uint64_t nOutPackets = 0; ///< number of packets written
+  };
+
+  /** \brief default maximum number of bytes gathered into one write operation
+   */
+  static const size_t DEFAULT_MAX_WRITE_BATCH_BYTES;
+
+  /** \brief default maximum number of memory blocks gathered into one write operation
+   */
+  static const size_t DEFAULT_MAX_WRITE_BATCH_BUFFERS;
+
   Transport();
 
   virtual
@@ -111,6 +141,18 @@ public:
   bool
   isReceiving() const;
 
+  /** \brief set limits on how many queued packets are gathered into one write operation
+   *  \param maxBytes maximum number of bytes per write operation; a single packet that exceeds
+   *                  this limit is still written as a whole
+   *  \param maxBuffers maximum number of memory blocks per write operation; must not be zero
+   *  \note This has no effect on datagram-oriented transports.
+   */
+  void
+  setWriteBatchLimits(size_t maxBytes, size_t maxBuffers);
+
+  const WriteCounters&
+  getWriteCounters() const;
+
 protected:
   /** \brief invoke the receive callback
    */
@@ -122,6 +164,10 @@ protected:
   bool m_isConnected;
   bool m_isReceiving;
   ReceiveCallback m_receiveCallback;
+
+  size_t m_maxWriteBatchBytes;
+  size_t m_maxWriteBatchBuffers;
+  WriteCounters m_writeCounters;
 };
 
 inline bool
@@ -136,6 +182,12 @@ Transport::isReceiving() const
   return m_isReceiving;
 }
 
+inline const Transport::WriteCounters&
+Transport::getWriteCounters() const
+{
+  return m_writeCounters;
+}
+
 inline void
 Transport::receive(const Block& wire)
 {
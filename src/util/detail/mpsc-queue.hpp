@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_DETAIL_MPSC_QUEUE_HPP
+#define NDN_UTIL_DETAIL_MPSC_QUEUE_HPP
+
+#include "../../common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+/** \brief an unbounded lock-free multi-producer single-consumer queue
+ *
+ *  Producers append a node with a single atomic exchange and never block each other or the
+ *  consumer.  The consumer takes nodes from the other end without synchronizing with the
+ *  producers other than through the node links.
+ *
+ *  \note push may be called from any thread, pop must only be called from one thread at a time.
+ *  \note A value that is being pushed may be invisible to pop until its push has returned.
+ */
+template<typename T>
+class MpscQueue : noncopyable
+{
+public:
+  MpscQueue()
+    : m_head(new Node)
+    , m_tail(m_head.load())
+  {
+  }
+
+  ~MpscQueue()
+  {
+    T value;
+    while (pop(value)) {
+    }
+    delete m_tail;
+  }
+
+  void
+  push(T value)
+  {
+    Node* node = new Node;
+    node->value = std::move(value);
+    Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  /** \brief take the oldest value out of the queue
+   *  \retval false the queue is empty
+   */
+  bool
+  pop(T& value)
+  {
+    Node* next = m_tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    value = std::move(next->value);
+    delete m_tail;
+    m_tail = next; // next becomes the sentinel node
+    return true;
+  }
+
+private:
+  struct Node
+  {
+    std::atomic<Node*> next{nullptr};
+    T value;
+  };
+
+  std::atomic<Node*> m_head; ///< last pushed node, written by producers
+  Node* m_tail; ///< sentinel node preceding the oldest value, owned by the consumer
+};
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_DETAIL_MPSC_QUEUE_HPP
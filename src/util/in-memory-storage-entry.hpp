@@ -92,7 +92,7 @@ public:
   /** @brief Check if the data can satisfy an interest with MustBeFresh
    */
   bool
-  isFresh()
+  isFresh() const
   {
     return m_isFresh;
   }
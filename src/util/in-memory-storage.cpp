@@ -193,7 +193,7 @@ InMemoryStorage::insert(const Data& data, const time::milliseconds& mustBeFreshP
   if (m_scheduler != nullptr && mustBeFreshProcessingWindow > ZERO_WINDOW) {
     auto eventId = make_unique<scheduler::ScopedEventId>(*m_scheduler);
     *eventId = m_scheduler->scheduleEvent(mustBeFreshProcessingWindow,
-                                          bind(&InMemoryStorageEntry::markStale, entry));
+                                          bind(&InMemoryStorage::markStale, this, entry));
     entry->setMarkStaleEventId(std::move(eventId));
   }
   m_cache.insert(entry);
@@ -224,47 +224,111 @@ InMemoryStorage::find(const Name& name)
 shared_ptr<const Data>
 InMemoryStorage::find(const Interest& interest)
 {
+  const Name& interestName = interest.getName();
+  Cache::index<byFullName>::type::iterator it;
+
   //if the interest contains implicit digest, it is possible to directly locate a packet.
-  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>()
-                                                    .find(interest.getName());
+  //a full name always ends with the implicit digest, so other names need not be looked up.
+  if (!interestName.empty() && interestName.get(-1).isImplicitSha256Digest()) {
+    it = m_cache.get<byFullName>().find(interestName);
 
-  //if a packet is located by its full name, it must be the packet to return.
-  if (it != m_cache.get<byFullName>().end()) {
-    return ((*it)->getData()).shared_from_this();
+    //if a packet is located by its full name, it must be the packet to return.
+    if (it != m_cache.get<byFullName>().end()) {
+      return ((*it)->getData()).shared_from_this();
+    }
   }
 
   //if the packet is not discovered by last step, either the packet is not in the storage or
   //the interest doesn't contains implicit digest.
-  it = m_cache.get<byFullName>().lower_bound(interest.getName());
+  InMemoryStorageEntry* ret = nullptr;
+  bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
+  if (hasLeftmostSelector)
+    ret = findExactName(interest);
 
-  if (it == m_cache.get<byFullName>().end()) {
+  if (ret == nullptr) {
+    if (hasLeftmostSelector && interest.getMustBeFresh()) {
+      ret = selectLeftmostFresh(interest);
+    }
+    else {
+      it = m_cache.get<byFullName>().lower_bound(interestName);
+
+      if (it != m_cache.get<byFullName>().end()) {
+        //to locate the element that has a just smaller name than the interest's
+        if (it != m_cache.get<byFullName>().begin())
+          it--;
+
+        ret = selectChild(interest, it);
+      }
+    }
+  }
+
+  if (ret == nullptr) {
     return shared_ptr<const Data>();
   }
 
-  //to locate the element that has a just smaller name than the interest's
-  if (it != m_cache.get<byFullName>().begin())
-    it--;
+  //let derived class do something with the entry
+  afterAccess(ret);
+  return ret->getData().shared_from_this();
+}
 
-  InMemoryStorageEntry* ret = selectChild(interest, it);
-  if (ret != 0) {
-    //let derived class do something with the entry
-    afterAccess(ret);
-    return ret->getData().shared_from_this();
+InMemoryStorageEntry*
+InMemoryStorage::findExactName(const Interest& interest) const
+{
+  InMemoryStorageEntry* ret = nullptr;
+
+  auto range = m_cache.get<byName>().equal_range(interest.getName());
+  for (auto it = range.first; it != range.second; ++it) {
+    if (interest.getMustBeFresh() && !(*it)->isFresh())
+      continue;
+
+    if ((ret == nullptr || (*it)->getFullName() < ret->getFullName()) &&
+        interest.matchesData((*it)->getData()))
+      ret = *it;
   }
-  else {
-    return shared_ptr<const Data>();
+
+  return ret;
+}
+
+InMemoryStorageEntry*
+InMemoryStorage::selectLeftmostFresh(const Interest& interest) const
+{
+  const Cache::index<byFreshness>::type& freshIndex = m_cache.get<byFreshness>();
+
+  for (Cache::index<byFreshness>::type::iterator it =
+         freshIndex.lower_bound(boost::make_tuple(true, interest.getName()));
+       it != freshIndex.end() && (*it)->isFresh() &&
+         interest.getName().isPrefixOf((*it)->getFullName());
+       ++it) {
+    if (interest.matchesData((*it)->getData()))
+      return *it;
   }
+
+  return nullptr;
 }
 
 InMemoryStorage::Cache::index<InMemoryStorage::byFullName>::type::iterator
 InMemoryStorage::findNextFresh(Cache::index<byFullName>::type::iterator it) const
 {
-  for (; it != m_cache.get<byFullName>().end(); it++) {
-    if ((*it)->isFresh())
-      return it;
-  }
+  if (it == m_cache.get<byFullName>().end() || (*it)->isFresh())
+    return it;
+
+  const Cache::index<byFreshness>::type& freshIndex = m_cache.get<byFreshness>();
+  Cache::index<byFreshness>::type::iterator freshIt =
+    freshIndex.lower_bound(boost::make_tuple(true, (*it)->getFullName()));
+
+  if (freshIt == freshIndex.end() || !(*freshIt)->isFresh())
+    return m_cache.get<byFullName>().end();
 
-  return it;
+  return m_cache.project<byFullName>(freshIt);
+}
+
+void
+InMemoryStorage::markStale(InMemoryStorageEntry* entry)
+{
+  Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(entry->getFullName());
+  BOOST_ASSERT(it != m_cache.get<byFullName>().end());
+
+  m_cache.modify(it, [] (InMemoryStorageEntry* e) { e->markStale(); });
 }
 
 InMemoryStorageEntry*
@@ -365,11 +429,15 @@ InMemoryStorage::selectChild(const Interest& interest,
 InMemoryStorage::Cache::iterator
 InMemoryStorage::freeEntry(Cache::iterator it)
 {
+  InMemoryStorageEntry* entry = *it;
+  // the entry must be unlinked from all indexes while its Data is still present
+  Cache::iterator next = m_cache.erase(it);
+
   //push the *empty* entry into mem pool
-  (*it)->release();
-  m_freeEntries.push(*it);
+  entry->release();
+  m_freeEntries.push(entry);
   m_nPackets--;
-  return m_cache.erase(it);
+  return next;
 }
 
 void
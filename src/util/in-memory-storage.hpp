@@ -31,6 +31,8 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -48,6 +50,8 @@ class InMemoryStorage : noncopyable
 public:
   //multi_index_container to implement storage
   class byFullName;
+  class byName;
+  class byFreshness;
 
   typedef boost::multi_index_container<
     InMemoryStorageEntry*,
@@ -59,6 +63,30 @@ public:
         boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
                                           &InMemoryStorageEntry::getFullName>,
         std::less<Name>
+      >,
+
+      // by Name without implicit digest, for exact-name lookups
+      boost::multi_index::hashed_non_unique<
+        boost::multi_index::tag<byName>,
+        boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
+                                          &InMemoryStorageEntry::getName>,
+        std::hash<Name>
+      >,
+
+      // fresh entries first, then stale entries, each partition ordered by Full Name
+      boost::multi_index::ordered_unique<
+        boost::multi_index::tag<byFreshness>,
+        boost::multi_index::composite_key<
+          InMemoryStorageEntry*,
+          boost::multi_index::const_mem_fun<InMemoryStorageEntry, bool,
+                                            &InMemoryStorageEntry::isFresh>,
+          boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
+                                            &InMemoryStorageEntry::getFullName>
+        >,
+        boost::multi_index::composite_key_compare<
+          std::greater<bool>,
+          std::less<Name>
+        >
       >
 
     >
@@ -308,7 +336,27 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   selectChild(const Interest& interest,
               Cache::index<byFullName>::type::iterator startingPoint) const;
 
+  /** @brief Finds the leftmost match among Data whose name equals the Interest name
+   *
+   *  In canonical order, such Data precede all other Data under the Interest name,
+   *  therefore if one of them matches, it is the leftmost match.
+   *  @return{ the match with the smallest full name, if any; otherwise nullptr }
+   */
+  InMemoryStorageEntry*
+  findExactName(const Interest& interest) const;
+
+  /** @brief Implements leftmost child selector for an Interest with MustBeFresh
+   *
+   *  Iterates over the fresh partition of the byFreshness index only, starting from the
+   *  Interest Name, so stale entries under the Interest Name are not visited.
+   *  @return{ the leftmost fresh match, if any; otherwise nullptr }
+   */
+  InMemoryStorageEntry*
+  selectLeftmostFresh(const Interest& interest) const;
+
   /** @brief Get the next iterator (include startingPoint) that satisfies MustBeFresh requirement
+   *
+   *  The lookup is done on the byFreshness index, so stale entries are not visited.
    *
    *  @param startingPoint The iterator to start with.
    *  @return The next qualified iterator
@@ -316,6 +364,13 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Cache::index<byFullName>::type::iterator
   findNextFresh(Cache::index<byFullName>::type::iterator startingPoint) const;
 
+  /** @brief Disables @p entry from satisfying Interests with MustBeFresh
+   *
+   *  The entry is moved to the stale partition of the byFreshness index.
+   */
+  void
+  markStale(InMemoryStorageEntry* entry);
+
 private:
   void
   init();
@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "regex-automaton.hpp"
+#include "regex-matcher.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace ndn {
+
+const size_t RegexAutomaton::NONE = std::numeric_limits<size_t>::max();
+
+/**
+ * @return compiled @p expr, shared with other automata, or nullptr if @p expr matches any
+ *         component
+ */
+static shared_ptr<const boost::regex>
+getComponentRegex(const std::string& expr)
+{
+  if (expr.empty() || expr == ".*") {
+    return nullptr;
+  }
+
+  static std::mutex mutex;
+  static std::unordered_map<std::string, weak_ptr<const boost::regex>> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& entry = cache[expr];
+  auto regex = entry.lock();
+  if (regex == nullptr) {
+    regex = make_shared<const boost::regex>(expr);
+    entry = regex;
+  }
+
+  if (cache.size() > 1024) {
+    for (auto it = cache.begin(); it != cache.end();) {
+      if (it->second.expired()) {
+        it = cache.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+  return regex;
+}
+
+/**
+ * @return index of the character after the sub pattern that starts after @p left at @p index
+ */
+static size_t
+skipSubPattern(const std::string& expr, char left, char right, size_t index)
+{
+  size_t lcount = 1;
+  size_t rcount = 0;
+  while (lcount > rcount) {
+    if (index >= expr.size()) {
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Parenthesis mismatch"));
+    }
+    if (expr[index] == left) {
+      ++lcount;
+    }
+    else if (expr[index] == right) {
+      ++rcount;
+    }
+    ++index;
+  }
+  return index;
+}
+
+RegexAutomaton::RegexAutomaton(const std::string& expr)
+{
+  std::vector<Element> patternList = parsePatternList(expr, 0, expr.size());
+  Fragment fragment = compilePatternList(patternList);
+  connect(fragment, addState(State::ACCEPT));
+  m_start = fragment.start;
+}
+
+std::vector<RegexAutomaton::Element>
+RegexAutomaton::parsePatternList(const std::string& expr, size_t begin, size_t end)
+{
+  std::vector<Element> patternList;
+  size_t index = begin;
+  while (index < end) {
+    Element element;
+    size_t subEnd = 0;
+    switch (expr[index]) {
+    case '(':
+      subEnd = skipSubPattern(expr, '(', ')', index + 1);
+      element.isGroup = true;
+      element.componentSet = NONE;
+      element.group = parsePatternList(expr, index + 1, subEnd - 1);
+      break;
+    case '<':
+      subEnd = skipSubPattern(expr, '<', '>', index + 1);
+      element.isGroup = false;
+      element.componentSet = parseComponentSet(expr.substr(index, subEnd - index));
+      break;
+    case '[':
+      subEnd = skipSubPattern(expr, '[', ']', index + 1);
+      element.isGroup = false;
+      element.componentSet = parseComponentSet(expr.substr(index, subEnd - index));
+      break;
+    default:
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Unexpected syntax"));
+    }
+
+    if (subEnd > end) {
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Parenthesis mismatch"));
+    }
+    index = parseRepetition(expr, subEnd, end, element);
+    patternList.push_back(std::move(element));
+  }
+  return patternList;
+}
+
+size_t
+RegexAutomaton::parseRepetition(const std::string& expr, size_t index, size_t end,
+                                Element& element)
+{
+  element.repeatMin = 1;
+  element.repeatMax = 1;
+  if (index == end) {
+    return index;
+  }
+
+  switch (expr[index]) {
+  case '?':
+    element.repeatMin = 0;
+    return index + 1;
+  case '+':
+    element.repeatMax = NONE;
+    return index + 1;
+  case '*':
+    element.repeatMin = 0;
+    element.repeatMax = NONE;
+    return index + 1;
+  case '{':
+    break;
+  default:
+    return index;
+  }
+
+  size_t close = expr.find('}', index);
+  if (close == std::string::npos || close >= end) {
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Missing right brace bracket"));
+  }
+
+  static const boost::regex REPETITION("\\{([0-9]*)(,?)([0-9]*)\\}");
+  boost::smatch match;
+  std::string repetition = expr.substr(index, close + 1 - index);
+  if (!boost::regex_match(repetition, match, REPETITION) ||
+      (match[1].length() == 0 && (match[2].length() == 0 || match[3].length() == 0))) {
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Unrecognized repetition " + repetition));
+  }
+
+  element.repeatMin = match[1].length() == 0 ? 0 : std::stoul(match[1].str());
+  if (match[2].length() == 0) {
+    element.repeatMax = element.repeatMin;
+  }
+  else {
+    element.repeatMax = match[3].length() == 0 ? NONE : std::stoul(match[3].str());
+  }
+  if (element.repeatMin > element.repeatMax) {
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Wrong number " + repetition));
+  }
+  return close + 1;
+}
+
+size_t
+RegexAutomaton::parseComponentSet(const std::string& expr)
+{
+  ComponentSet componentSet;
+  componentSet.isInclusion = true;
+  componentSet.containsAny = false;
+
+  size_t index = 0;
+  size_t end = expr.size();
+  if (expr[0] == '[') {
+    end = expr.size() - 1;
+    index = 1;
+    if (index < end && expr[index] == '^') {
+      componentSet.isInclusion = false;
+      ++index;
+    }
+  }
+
+  while (index < end) {
+    if (expr[index] != '<') {
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Component expr error " + expr));
+    }
+    size_t componentEnd = skipSubPattern(expr, '<', '>', index + 1);
+    auto regex = getComponentRegex(expr.substr(index + 1, componentEnd - index - 2));
+    if (regex == nullptr) {
+      componentSet.containsAny = true;
+    }
+    else {
+      componentSet.regexes.push_back(std::move(regex));
+    }
+    index = componentEnd;
+  }
+
+  m_componentSets.push_back(std::move(componentSet));
+  return m_componentSets.size() - 1;
+}
+
+size_t
+RegexAutomaton::addState(State::Type type, size_t componentSet, size_t out, size_t out1)
+{
+  m_states.push_back({type, componentSet, out, out1});
+  return m_states.size() - 1;
+}
+
+void
+RegexAutomaton::connect(const Fragment& fragment, size_t target)
+{
+  for (const auto& out : fragment.outs) {
+    (out.second ? m_states[out.first].out1 : m_states[out.first].out) = target;
+  }
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::concatenate(Fragment first, const Fragment& second)
+{
+  connect(first, second.start);
+  first.outs = second.outs;
+  return first;
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::makeEmpty()
+{
+  size_t state = addState(State::SPLIT);
+  return {state, {{state, false}}};
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::compilePatternList(const std::vector<Element>& patternList)
+{
+  Fragment fragment = makeEmpty();
+  for (const Element& element : patternList) {
+    fragment = concatenate(std::move(fragment), compileElement(element));
+  }
+  return fragment;
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::compileElement(const Element& element)
+{
+  auto compileOnce = [this, &element] {
+    if (element.isGroup) {
+      return compilePatternList(element.group);
+    }
+    size_t state = addState(State::CONSUME, element.componentSet);
+    return Fragment{state, {{state, false}}};
+  };
+
+  Fragment fragment = makeEmpty();
+  for (size_t i = 0; i < element.repeatMin; ++i) {
+    fragment = concatenate(std::move(fragment), compileOnce());
+  }
+
+  if (element.repeatMax == NONE) {
+    Fragment body = compileOnce();
+    size_t loop = addState(State::SPLIT, NONE, body.start);
+    connect(body, loop);
+    return concatenate(std::move(fragment), {loop, {{loop, true}}});
+  }
+
+  for (size_t i = element.repeatMin; i < element.repeatMax; ++i) {
+    Fragment body = compileOnce();
+    size_t optional = addState(State::SPLIT, NONE, body.start);
+    body.start = optional;
+    body.outs.emplace_back(optional, true);
+    fragment = concatenate(std::move(fragment), body);
+  }
+  return fragment;
+}
+
+void
+RegexAutomaton::addClosure(std::vector<size_t>& states, std::vector<size_t>& marks,
+                           size_t generation, size_t state) const
+{
+  std::vector<size_t> stack{state};
+  while (!stack.empty()) {
+    size_t current = stack.back();
+    stack.pop_back();
+    if (current == NONE || marks[current] == generation) {
+      continue;
+    }
+    marks[current] = generation;
+
+    const State& s = m_states[current];
+    if (s.type == State::SPLIT) {
+      stack.push_back(s.out1);
+      stack.push_back(s.out);
+    }
+    else {
+      states.push_back(current);
+    }
+  }
+}
+
+bool
+RegexAutomaton::isInSet(const ComponentSet& componentSet, const name::Component& component,
+                        std::string& componentUri)
+{
+  bool isFound = componentSet.containsAny;
+  for (auto it = componentSet.regexes.begin(); !isFound && it != componentSet.regexes.end(); ++it) {
+    if (componentUri.empty()) {
+      componentUri = component.toUri();
+    }
+    isFound = boost::regex_match(componentUri, **it);
+  }
+  return componentSet.isInclusion == isFound;
+}
+
+bool
+RegexAutomaton::match(const Name& name) const
+{
+  std::vector<size_t> marks(m_states.size(), NONE);
+  std::vector<size_t> current;
+  std::vector<size_t> next;
+  size_t generation = 0;
+  addClosure(current, marks, generation, m_start);
+
+  // outcome of each component set for the current component: -1 unknown, 0 no, 1 yes
+  std::vector<int8_t> isInSets(m_componentSets.size());
+  std::string componentUri;
+  for (const name::Component& component : name) {
+    if (current.empty()) {
+      return false;
+    }
+
+    ++generation;
+    next.clear();
+    std::fill(isInSets.begin(), isInSets.end(), -1);
+    componentUri.clear();
+
+    for (size_t state : current) {
+      const State& s = m_states[state];
+      if (s.type != State::CONSUME) {
+        continue;
+      }
+      int8_t& isInSet = isInSets[s.componentSet];
+      if (isInSet < 0) {
+        isInSet = RegexAutomaton::isInSet(m_componentSets[s.componentSet], component, componentUri);
+      }
+      if (isInSet) {
+        addClosure(next, marks, generation, s.out);
+      }
+    }
+    current.swap(next);
+  }
+
+  return std::any_of(current.begin(), current.end(),
+                     [this] (size_t state) { return m_states[state].type == State::ACCEPT; });
+}
+
+} // namespace ndn
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
+#define NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
+
+#include "../../name.hpp"
+
+#include <boost/regex.hpp>
+
+namespace ndn {
+
+/**
+ * @brief A name regex compiled into a nondeterministic automaton over name components
+ *
+ * Each transition of the automaton consumes one name component that belongs to a component
+ * set, i.e. `<...>` or `[...]`.  The regular expressions of the components are compiled once
+ * and shared among all automata.  Matching follows all states of the automaton at once, so
+ * that it takes time linear in the number of name components, and each component set is
+ * tested at most once per component.
+ *
+ * The automaton only decides whether a name matches.  Back references are recorded by the
+ * backtracking matchers of RegexTopMatcher.
+ */
+class RegexAutomaton : noncopyable
+{
+public:
+  /**
+   * @brief Compile a pattern list, i.e. a regex without the leading `^` and the trailing `$`
+   * @throw RegexMatcher::Error the expression cannot be parsed
+   */
+  explicit
+  RegexAutomaton(const std::string& expr);
+
+  /**
+   * @return whether the pattern list matches all components of @p name
+   */
+  bool
+  match(const Name& name) const;
+
+  size_t
+  getNStates() const
+  {
+    return m_states.size();
+  }
+
+private:
+  /**
+   * @brief A parsed element of a pattern list, with its repetition
+   */
+  struct Element
+  {
+    bool isGroup;
+    size_t componentSet;
+    std::vector<Element> group;
+    size_t repeatMin;
+    size_t repeatMax;
+  };
+
+  struct ComponentSet
+  {
+    bool isInclusion;
+    /// whether any component is in the set without evaluating a regular expression
+    bool containsAny;
+    std::vector<shared_ptr<const boost::regex>> regexes;
+  };
+
+  struct State
+  {
+    enum Type {
+      CONSUME, ///< consume a component in m_componentSets[componentSet], then go to out
+      SPLIT,   ///< go to out and to out1 without consuming, if they are not NONE
+      ACCEPT
+    };
+
+    Type type;
+    size_t componentSet;
+    size_t out;
+    size_t out1;
+  };
+
+  /**
+   * @brief A partially built automaton: its start state, and its unconnected transitions
+   */
+  struct Fragment
+  {
+    size_t start;
+    /// (state, whether it is the out1 transition)
+    std::vector<std::pair<size_t, bool>> outs;
+  };
+
+  std::vector<Element>
+  parsePatternList(const std::string& expr, size_t begin, size_t end);
+
+  size_t
+  parseRepetition(const std::string& expr, size_t index, size_t end, Element& element);
+
+  size_t
+  parseComponentSet(const std::string& expr);
+
+  size_t
+  addState(State::Type type, size_t componentSet = NONE, size_t out = NONE, size_t out1 = NONE);
+
+  void
+  connect(const Fragment& fragment, size_t target);
+
+  Fragment
+  concatenate(Fragment first, const Fragment& second);
+
+  Fragment
+  makeEmpty();
+
+  Fragment
+  compilePatternList(const std::vector<Element>& patternList);
+
+  Fragment
+  compileElement(const Element& element);
+
+  /**
+   * @brief Add @p state and the states reachable from it without consuming a component
+   */
+  void
+  addClosure(std::vector<size_t>& states, std::vector<size_t>& marks, size_t generation,
+             size_t state) const;
+
+  /**
+   * @param componentUri URI of @p component, computed on first use if empty
+   */
+  static bool
+  isInSet(const ComponentSet& componentSet, const name::Component& component,
+          std::string& componentUri);
+
+private:
+  static const size_t NONE;
+
+  std::vector<ComponentSet> m_componentSets;
+  std::vector<State> m_states;
+  size_t m_start;
+};
+
+} // namespace ndn
+
+#endif // NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
@@ -23,6 +23,7 @@
 
 #include "regex-top-matcher.hpp"
 
+#include "regex-automaton.hpp"
 #include "regex-backref-manager.hpp"
 #include "regex-pattern-list-matcher.hpp"
 
@@ -34,6 +35,7 @@ RegexTopMatcher::RegexTopMatcher(const std::string& expr, const std::string& exp
   : RegexMatcher(expr, EXPR_TOP)
   , m_expand(expand)
   , m_isSecondaryUsed(false)
+  , m_hasUnresolvedBackrefs(false)
 {
   m_primaryBackrefManager = make_shared<RegexBackrefManager>();
   m_secondaryBackrefManager = make_shared<RegexBackrefManager>();
@@ -69,12 +71,36 @@ RegexTopMatcher::compile()
   // because the argument-dependent lookup prefers STL to boost
   m_primaryMatcher = ndn::make_shared<RegexPatternListMatcher>(expr,
                                                                m_primaryBackrefManager);
+
+  // the secondary pattern list accepts every name the primary one accepts
+  m_automaton = make_shared<RegexAutomaton>(m_secondaryMatcher != nullptr ? "<.*>*" + expr : expr);
 }
 
 bool
 RegexTopMatcher::match(const Name& name)
 {
   m_isSecondaryUsed = false;
+  m_hasUnresolvedBackrefs = false;
+
+  m_matchResult.clear();
+
+  if (!m_automaton->match(name))
+    return false;
+
+  m_matchResult.assign(name.begin(), name.end());
+
+  if (m_primaryBackrefManager->size() > 0 || m_secondaryBackrefManager->size() > 0) {
+    m_unresolvedName = name;
+    m_hasUnresolvedBackrefs = true;
+  }
+  return true;
+}
+
+bool
+RegexTopMatcher::matchByBacktracking(const Name& name)
+{
+  m_hasUnresolvedBackrefs = false;
+  m_isSecondaryUsed = false;
 
   m_matchResult.clear();
 
@@ -104,6 +130,9 @@ RegexTopMatcher::match(const Name& name, size_t, size_t)
 Name
 RegexTopMatcher::expand(const std::string& expandStr)
 {
+  if (m_hasUnresolvedBackrefs)
+    matchByBacktracking(m_unresolvedName);
+
   Name result;
 
   shared_ptr<RegexBackrefManager> backrefManager =
@@ -32,6 +32,7 @@ namespace ndn {
 
 class RegexPatternListMatcher;
 class RegexBackrefManager;
+class RegexAutomaton;
 
 class RegexTopMatcher: public RegexMatcher
 {
@@ -41,6 +42,12 @@ public:
   virtual
   ~RegexTopMatcher();
 
+  /**
+   * @brief Check whether @p name matches the expression
+   *
+   * The name is matched by a compiled automaton.  When the expression contains back
+   * references, they are recorded only when needed by a subsequent expand().
+   */
   bool
   match(const Name& name);
 
@@ -57,6 +64,13 @@ protected:
   virtual void
   compile();
 
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * @brief Match @p name with the backtracking matchers, recording the back references
+   */
+  bool
+  matchByBacktracking(const Name& name);
+
 private:
   std::string
   getItemFromExpand(const std::string& expand, size_t& offset);
@@ -71,6 +85,12 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   shared_ptr<RegexBackrefManager> m_primaryBackrefManager;
   shared_ptr<RegexBackrefManager> m_secondaryBackrefManager;
   bool m_isSecondaryUsed;
+  shared_ptr<const RegexAutomaton> m_automaton; ///< immutable, shared by copies
+
+  /** @brief the last matched name, whose back references have not been recorded yet
+   */
+  Name m_unresolvedName;
+  bool m_hasUnresolvedBackrefs;
 };
 
 } // namespace ndn
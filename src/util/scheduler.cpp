@@ -22,10 +22,14 @@
 #include "scheduler.hpp"
 #include <boost/scope_exit.hpp>
 
+#include <mutex>
+
 namespace ndn {
 namespace util {
 namespace scheduler {
 
+typedef std::multiset<shared_ptr<EventInfo>, EventQueueCompare> EventSet;
+
 class EventInfo : noncopyable
 {
 public:
@@ -46,7 +50,7 @@ public:
   time::steady_clock::TimePoint expireTime;
   bool isExpired;
   EventCallback callback;
-  EventQueue::const_iterator queueIt;
+  EventSet::const_iterator setIt; ///< position in OrderedSetEventQueue
 };
 
 bool
@@ -68,32 +72,348 @@ operator<<(std::ostream& os, const EventId& eventId)
   return os << eventId.m_info.lock();
 }
 
+std::ostream&
+operator<<(std::ostream& os, EventQueueType type)
+{
+  switch (type) {
+  case EventQueueType::ORDERED_SET:
+    return os << "ordered-set";
+  case EventQueueType::BINARY_HEAP:
+    return os << "binary-heap";
+  }
+  return os << static_cast<int>(type);
+}
+
 bool
 EventQueueCompare::operator()(const shared_ptr<EventInfo>& a, const shared_ptr<EventInfo>& b) const
 {
   return a->expireTime < b->expireTime;
 }
 
-Scheduler::Scheduler(boost::asio::io_service& ioService)
+class EventQueueImpl : noncopyable
+{
+public:
+  virtual
+  ~EventQueueImpl() = default;
+
+  /**
+   * \brief create an event and insert it into the queue
+   */
+  virtual shared_ptr<EventInfo>
+  insert(time::nanoseconds after, const EventCallback& callback) = 0;
+
+  /**
+   * \brief remove an event that is in the queue
+   */
+  virtual void
+  erase(EventInfo& info) = 0;
+
+  virtual void
+  clear() = 0;
+
+  virtual bool
+  empty() const = 0;
+
+  /**
+   * \return the event that expires first
+   * \pre !empty()
+   */
+  virtual const shared_ptr<EventInfo>&
+  front() const = 0;
+};
+
+class OrderedSetEventQueue final : public EventQueueImpl
+{
+public:
+  shared_ptr<EventInfo>
+  insert(time::nanoseconds after, const EventCallback& callback) final
+  {
+    // multiset inserts after existing elements with the same key, preserving scheduling order
+    EventSet::iterator i = m_set.insert(make_shared<EventInfo>(after, callback));
+    (*i)->setIt = i;
+    return *i;
+  }
+
+  void
+  erase(EventInfo& info) final
+  {
+    m_set.erase(info.setIt);
+  }
+
+  void
+  clear() final
+  {
+    m_set.clear();
+  }
+
+  bool
+  empty() const final
+  {
+    return m_set.empty();
+  }
+
+  const shared_ptr<EventInfo>&
+  front() const final
+  {
+    return *m_set.begin();
+  }
+
+private:
+  EventSet m_set;
+};
+
+/**
+ * \brief Pool of equally sized memory blocks recycled through a free list
+ *
+ * The pool is shared by its allocators, because an EventId can keep the control block of
+ * an EventInfo alive after the Scheduler has been destroyed.  The last copy of an EventId
+ * may be dropped on another thread than the one running the Scheduler, so the free list is
+ * protected by a mutex.
+ */
+class EventInfoPool : noncopyable
+{
+public:
+  ~EventInfoPool()
+  {
+    for (void* block : m_freeBlocks) {
+      ::operator delete(block);
+    }
+  }
+
+  void*
+  allocate(size_t size)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_blockSize == 0) {
+      m_blockSize = size;
+    }
+    if (size != m_blockSize || m_freeBlocks.empty()) {
+      return ::operator new(size);
+    }
+    void* block = m_freeBlocks.back();
+    m_freeBlocks.pop_back();
+    return block;
+  }
+
+  void
+  deallocate(void* block, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (size != m_blockSize || m_freeBlocks.size() >= MAX_FREE_BLOCKS) {
+      ::operator delete(block);
+      return;
+    }
+    m_freeBlocks.push_back(block);
+  }
+
+private:
+  static const size_t MAX_FREE_BLOCKS = 65536;
+
+  std::mutex m_mutex;
+  size_t m_blockSize = 0;
+  std::vector<void*> m_freeBlocks;
+};
+
+template<typename T>
+class EventInfoAllocator
+{
+public:
+  typedef T value_type;
+
+  explicit
+  EventInfoAllocator(const shared_ptr<EventInfoPool>& pool)
+    : m_pool(pool)
+  {
+  }
+
+  template<typename U>
+  EventInfoAllocator(const EventInfoAllocator<U>& other)
+    : m_pool(other.m_pool)
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    m_pool->deallocate(p, n * sizeof(T));
+  }
+
+  template<typename U>
+  bool
+  operator==(const EventInfoAllocator<U>& other) const
+  {
+    return m_pool == other.m_pool;
+  }
+
+  template<typename U>
+  bool
+  operator!=(const EventInfoAllocator<U>& other) const
+  {
+    return m_pool != other.m_pool;
+  }
+
+private:
+  shared_ptr<EventInfoPool> m_pool;
+
+  template<typename U>
+  friend class EventInfoAllocator;
+};
+
+/**
+ * \brief Event queue kept in a binary heap
+ *
+ * Removing an event other than the first one only marks it as expired and releases its
+ * callback; the event stays in the heap until it reaches the top, or until cancelled events
+ * make up half of the heap.  The heap entries hold the sort key, so that sifting does not
+ * touch the EventInfo.
+ */
+class BinaryHeapEventQueue final : public EventQueueImpl
+{
+public:
+  BinaryHeapEventQueue()
+    : m_pool(make_shared<EventInfoPool>())
+    , m_nextSeqNo(0)
+    , m_nCancelled(0)
+  {
+  }
+
+  shared_ptr<EventInfo>
+  insert(time::nanoseconds after, const EventCallback& callback) final
+  {
+    auto info = std::allocate_shared<EventInfo>(EventInfoAllocator<EventInfo>(m_pool),
+                                                after, callback);
+    m_heap.push_back(Entry{info->expireTime, m_nextSeqNo++, info});
+    std::push_heap(m_heap.begin(), m_heap.end(), &isAfter);
+    return info;
+  }
+
+  void
+  erase(EventInfo& info) final
+  {
+    if (m_heap.front().info.get() == &info) {
+      popFront();
+      return;
+    }
+
+    info.isExpired = true;
+    info.callback = nullptr;
+    ++m_nCancelled;
+    if (m_nCancelled > m_heap.size() / 2) {
+      removeCancelled();
+    }
+  }
+
+  void
+  clear() final
+  {
+    m_heap.clear();
+    m_nCancelled = 0;
+  }
+
+  bool
+  empty() const final
+  {
+    return m_heap.empty();
+  }
+
+  const shared_ptr<EventInfo>&
+  front() const final
+  {
+    return m_heap.front().info;
+  }
+
+private:
+  struct Entry
+  {
+    time::steady_clock::TimePoint expireTime;
+    uint64_t seqNo; ///< breaks ties of expireTime
+    shared_ptr<EventInfo> info;
+  };
+
+  /**
+   * \brief orders the heap so that the event that expires first is on top
+   */
+  static bool
+  isAfter(const Entry& a, const Entry& b)
+  {
+    return a.expireTime > b.expireTime ||
+           (a.expireTime == b.expireTime && a.seqNo > b.seqNo);
+  }
+
+  /**
+   * \brief remove the first event, and the cancelled events that follow it
+   * \post the first event, if any, is not cancelled
+   */
+  void
+  popFront()
+  {
+    std::pop_heap(m_heap.begin(), m_heap.end(), &isAfter);
+    m_heap.pop_back();
+
+    while (!m_heap.empty() && m_heap.front().info->isExpired) {
+      std::pop_heap(m_heap.begin(), m_heap.end(), &isAfter);
+      m_heap.pop_back();
+      --m_nCancelled;
+    }
+  }
+
+  void
+  removeCancelled()
+  {
+    m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(),
+                                [] (const Entry& entry) { return entry.info->isExpired; }),
+                 m_heap.end());
+    std::make_heap(m_heap.begin(), m_heap.end(), &isAfter);
+    m_nCancelled = 0;
+  }
+
+private:
+  shared_ptr<EventInfoPool> m_pool;
+  std::vector<Entry> m_heap;
+  uint64_t m_nextSeqNo;
+  size_t m_nCancelled;
+};
+
+static unique_ptr<EventQueueImpl>
+makeEventQueue(EventQueueType queueType)
+{
+  switch (queueType) {
+  case EventQueueType::BINARY_HEAP:
+    return make_unique<BinaryHeapEventQueue>();
+  case EventQueueType::ORDERED_SET:
+  default:
+    return make_unique<OrderedSetEventQueue>();
+  }
+}
+
+Scheduler::Scheduler(boost::asio::io_service& ioService, EventQueueType queueType)
   : m_deadlineTimer(ioService)
+  , m_queue(makeEventQueue(queueType))
   , m_isEventExecuting(false)
 {
 }
 
+Scheduler::~Scheduler() = default;
+
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after, const EventCallback& callback)
 {
   BOOST_ASSERT(callback != nullptr);
 
-  EventQueue::iterator i = m_queue.insert(make_shared<EventInfo>(after, callback));
-  (*i)->queueIt = i;
+  shared_ptr<EventInfo> info = m_queue->insert(after, callback);
 
-  if (!m_isEventExecuting && i == m_queue.begin()) {
+  if (!m_isEventExecuting && m_queue->front() == info) {
     // the new event is the first one to expire
     this->scheduleNext();
   }
 
-  return EventId(*i);
+  return EventId(info);
 }
 
 void
@@ -104,10 +424,14 @@ Scheduler::cancelEvent(const EventId& eventId)
     return; // event already expired or cancelled
   }
 
-  if (info->queueIt == m_queue.begin()) {
-    m_deadlineTimer.cancel();
+  if (m_queue->front() != info) {
+    // the deadline timer is set for another event
+    m_queue->erase(*info);
+    return;
   }
-  m_queue.erase(info->queueIt);
+
+  m_deadlineTimer.cancel();
+  m_queue->erase(*info);
 
   if (!m_isEventExecuting) {
     this->scheduleNext();
@@ -117,15 +441,15 @@ Scheduler::cancelEvent(const EventId& eventId)
 void
 Scheduler::cancelAllEvents()
 {
-  m_queue.clear();
+  m_queue->clear();
   m_deadlineTimer.cancel();
 }
 
 void
 Scheduler::scheduleNext()
 {
-  if (!m_queue.empty()) {
-    m_deadlineTimer.expires_from_now((*m_queue.begin())->expiresFromNow());
+  if (!m_queue->empty()) {
+    m_deadlineTimer.expires_from_now(m_queue->front()->expiresFromNow());
     m_deadlineTimer.async_wait(bind(&Scheduler::executeEvent, this, _1));
   }
 }
@@ -146,14 +470,13 @@ Scheduler::executeEvent(const boost::system::error_code& error)
 
   // process all expired events
   time::steady_clock::TimePoint now = time::steady_clock::now();
-  while (!m_queue.empty()) {
-    EventQueue::iterator head = m_queue.begin();
-    shared_ptr<EventInfo> info = *head;
+  while (!m_queue->empty()) {
+    shared_ptr<EventInfo> info = m_queue->front();
     if (info->expireTime > now) {
       break;
     }
 
-    m_queue.erase(head);
+    m_queue->erase(*info);
     info->isExpired = true;
     info->callback();
   }
@@ -112,6 +112,31 @@ private:
 std::ostream&
 operator<<(std::ostream& os, const EventId& eventId);
 
+/**
+ * \brief Data structure of a Scheduler
+ */
+enum class EventQueueType {
+  /**
+   * \brief events are kept in a balanced search tree
+   */
+  ORDERED_SET,
+  /**
+   * \brief events are kept in a binary heap, and their EventInfo is allocated from a pool
+   *
+   * A cancelled event is only marked and its callback released; the event is removed from the
+   * heap when it reaches the front, or when cancelled events make up half of the heap.
+   * Scheduling and cancelling an event is therefore cheaper than with ORDERED_SET, which
+   * matters when most events are cancelled before they expire (e.g., Interest timeouts).
+   */
+  BINARY_HEAP
+};
+
+std::ostream&
+operator<<(std::ostream& os, EventQueueType type);
+
+/**
+ * \deprecated Scheduler no longer exposes its queue; this type is kept for compatibility
+ */
 class EventQueueCompare
 {
 public:
@@ -119,8 +144,16 @@ public:
   operator()(const shared_ptr<EventInfo>& a, const shared_ptr<EventInfo>& b) const;
 };
 
+/**
+ * \deprecated Scheduler no longer exposes its queue; this type is kept for compatibility
+ */
 typedef std::multiset<shared_ptr<EventInfo>, EventQueueCompare> EventQueue;
 
+/**
+ * \brief Holds scheduled events in the order of their expiration
+ */
+class EventQueueImpl;
+
 /**
  * \brief Generic scheduler
  */
@@ -132,8 +165,17 @@ public:
    */
   typedef EventCallback Event;
 
+  /**
+   * \param ioService io_service to run the events on
+   * \param queueType data structure for the scheduled events; it does not affect the order in
+   *                  which events are executed: events expire in the order of their expiration
+   *                  time, and events with the same expiration time in the order of scheduling
+   */
   explicit
-  Scheduler(boost::asio::io_service& ioService);
+  Scheduler(boost::asio::io_service& ioService,
+            EventQueueType queueType = EventQueueType::ORDERED_SET);
+
+  ~Scheduler();
 
   /**
    * \brief Schedule a one-time event after the specified delay
@@ -172,7 +214,7 @@ private:
 
 private:
   monotonic_deadline_timer m_deadlineTimer;
-  EventQueue m_queue;
+  unique_ptr<EventQueueImpl> m_queue;
   bool m_isEventExecuting;
 };
 
@@ -24,12 +24,25 @@
 #include "../name-component.hpp"
 #include "../lp/nack.hpp"
 #include "../lp/nack-header.hpp"
+#include "../lp/tags.hpp"
+
+#include <cmath>
 
 namespace ndn {
 namespace util {
 
 const uint32_t SegmentFetcher::MAX_INTEREST_REEXPRESS = 3;
 
+/**
+ * @return delay before an Interest Nacked with reason Congestion is expressed again, after it
+ *         has been retransmitted @p nRetransmissions times
+ */
+static time::milliseconds
+getCongestionBackoff(uint32_t nRetransmissions)
+{
+  return time::milliseconds(static_cast<uint32_t>(pow(2, nRetransmissions + 1)));
+}
+
 SegmentFetcher::SegmentFetcher(Face& face,
                                shared_ptr<Validator> validator,
                                const CompleteCallback& completeCallback,
@@ -40,6 +53,31 @@ SegmentFetcher::SegmentFetcher(Face& face,
   , m_completeCallback(completeCallback)
   , m_errorCallback(errorCallback)
   , m_buffer(make_shared<OBufferStream>())
+  , m_isStopped(false)
+  , m_cwnd(1.0)
+  , m_nextSegmentNo(0)
+  , m_nDeliveredSegments(0)
+  , m_nDeliveredBytes(0)
+  , m_recoveryPoint(0)
+  , m_discoveryInterestId(nullptr)
+{
+}
+
+SegmentFetcher::SegmentFetcher(Face& face,
+                               shared_ptr<Validator> validator,
+                               const Options& options)
+  : m_face(face)
+  , m_scheduler(m_face.getIoService())
+  , m_validator(validator)
+  , m_buffer(make_shared<OBufferStream>())
+  , m_options(options)
+  , m_isStopped(false)
+  , m_cwnd(std::max(1.0, options.initialWindow))
+  , m_nextSegmentNo(0)
+  , m_nDeliveredSegments(0)
+  , m_nDeliveredBytes(0)
+  , m_recoveryPoint(0)
+  , m_discoveryInterestId(nullptr)
 {
 }
 
@@ -68,6 +106,30 @@ SegmentFetcher::fetch(Face& face,
   fetcher->fetchFirstSegment(baseInterest, fetcher);
 }
 
+shared_ptr<SegmentFetcher>
+SegmentFetcher::start(Face& face,
+                      const Interest& baseInterest,
+                      shared_ptr<Validator> validator,
+                      const Options& options)
+{
+  shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher(face, validator, options));
+  fetcher->m_this = fetcher;
+  fetcher->m_baseInterest = baseInterest;
+  fetcher->expressDiscoveryInterest(0);
+  return fetcher;
+}
+
+void
+SegmentFetcher::stop()
+{
+  if (m_isStopped) {
+    return;
+  }
+  m_isStopped = true;
+  cancelPendingInterests();
+  m_this.reset();
+}
+
 void
 SegmentFetcher::fetchFirstSegment(const Interest& baseInterest,
                                   shared_ptr<SegmentFetcher> self)
@@ -77,7 +139,7 @@ SegmentFetcher::fetchFirstSegment(const Interest& baseInterest,
   interest.setMustBeFresh(true);
 
   m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::afterSegmentReceived, this, _1, _2, true, self),
+                         bind(&SegmentFetcher::handleSegmentReceived, this, _1, _2, true, self),
                          bind(&SegmentFetcher::afterNackReceived, this, _1, _2, 0, self),
                          bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
 }
@@ -93,15 +155,15 @@ SegmentFetcher::fetchNextSegment(const Interest& origInterest, const Name& dataN
   interest.setMustBeFresh(false);
   interest.setName(dataName.getPrefix(-1).appendSegment(segmentNo));
   m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::afterSegmentReceived, this, _1, _2, false, self),
+                         bind(&SegmentFetcher::handleSegmentReceived, this, _1, _2, false, self),
                          bind(&SegmentFetcher::afterNackReceived, this, _1, _2, 0, self),
                          bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
 }
 
 void
-SegmentFetcher::afterSegmentReceived(const Interest& origInterest,
-                                     const Data& data, bool isSegmentZeroExpected,
-                                     shared_ptr<SegmentFetcher> self)
+SegmentFetcher::handleSegmentReceived(const Interest& origInterest,
+                                      const Data& data, bool isSegmentZeroExpected,
+                                      shared_ptr<SegmentFetcher> self)
 {
   m_validator->validate(data,
                         bind(&SegmentFetcher::afterValidationSuccess, this, _1,
@@ -160,7 +222,7 @@ SegmentFetcher::afterNackReceived(const Interest& origInterest, const lp::Nack&
         reExpressInterest(origInterest, reExpressCount, self);
         break;
       case lp::NackReason::CONGESTION:
-        m_scheduler.scheduleEvent(time::milliseconds(static_cast<uint32_t>(pow(2, reExpressCount + 1))),
+        m_scheduler.scheduleEvent(getCongestionBackoff(reExpressCount),
                                   bind(&SegmentFetcher::reExpressInterest, this,
                                        origInterest, reExpressCount, self));
         break;
@@ -185,12 +247,337 @@ SegmentFetcher::reExpressInterest(Interest interest, uint32_t reExpressCount,
   }
 
   m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::afterSegmentReceived, this, _1, _2,
+                         bind(&SegmentFetcher::handleSegmentReceived, this, _1, _2,
                               isSegmentZeroExpected, self),
                          bind(&SegmentFetcher::afterNackReceived, this, _1, _2,
                               ++reExpressCount, self),
                          bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
 }
 
+void
+SegmentFetcher::expressDiscoveryInterest(uint32_t nRetransmissions)
+{
+  Interest interest(m_baseInterest);
+  interest.refreshNonce();
+  interest.setChildSelector(1);
+  interest.setMustBeFresh(true);
+
+  weak_ptr<SegmentFetcher> weakSelf = m_this;
+  m_discoveryInterestId = m_face.expressInterest(interest,
+    [=] (const Interest&, const Data& data) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->m_discoveryInterestId = nullptr;
+        self->afterWindowedDataReceived(data, true, 0);
+      }
+    },
+    [=] (const Interest&, const lp::Nack& nack) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->m_discoveryInterestId = nullptr;
+        self->afterWindowedNackReceived(nack, true, 0, nRetransmissions);
+      }
+    },
+    [=] (const Interest&) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->m_discoveryInterestId = nullptr;
+        self->afterWindowedTimeout(true, 0, nRetransmissions);
+      }
+    });
+}
+
+void
+SegmentFetcher::expressSegmentInterest(uint64_t segmentNo, uint32_t nRetransmissions)
+{
+  Interest interest(m_baseInterest); // to preserve any selectors
+  interest.refreshNonce();
+  interest.setChildSelector(0);
+  interest.setMustBeFresh(false);
+  interest.setName(Name(m_versionedName).appendSegment(segmentNo));
+
+  weak_ptr<SegmentFetcher> weakSelf = m_this;
+  const PendingInterestId* pendingInterestId = m_face.expressInterest(interest,
+    [=] (const Interest&, const Data& data) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->afterWindowedDataReceived(data, false, segmentNo);
+      }
+    },
+    [=] (const Interest&, const lp::Nack& nack) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->afterWindowedNackReceived(nack, false, segmentNo, nRetransmissions);
+      }
+    },
+    [=] (const Interest&) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->afterWindowedTimeout(false, segmentNo, nRetransmissions);
+      }
+    });
+
+  m_pendingSegments[segmentNo] = PendingSegment{pendingInterestId, nRetransmissions};
+}
+
+void
+SegmentFetcher::fillWindow()
+{
+  if (m_isStopped || m_versionedName.empty()) {
+    return;
+  }
+
+  size_t windowSize = static_cast<size_t>(std::floor(m_cwnd));
+  while (m_pendingSegments.size() < windowSize) {
+    if (!m_retxQueue.empty()) {
+      auto retx = m_retxQueue.begin();
+      uint64_t segmentNo = retx->first;
+      uint32_t nRetransmissions = retx->second;
+      m_retxQueue.erase(retx);
+      expressSegmentInterest(segmentNo, nRetransmissions);
+      continue;
+    }
+
+    while (m_nextSegmentNo < m_nDeliveredSegments ||
+           m_outOfOrderSegments.count(m_nextSegmentNo) > 0 ||
+           m_validatingSegments.count(m_nextSegmentNo) > 0 ||
+           m_pendingSegments.count(m_nextSegmentNo) > 0) {
+      ++m_nextSegmentNo;
+    }
+    if (m_nSegments && m_nextSegmentNo >= *m_nSegments) {
+      break;
+    }
+    expressSegmentInterest(m_nextSegmentNo++, 0);
+  }
+}
+
+void
+SegmentFetcher::afterWindowedDataReceived(const Data& data, bool isDiscovery, uint64_t segmentNo)
+{
+  if (m_isStopped) {
+    return;
+  }
+
+  if (!isDiscovery) {
+    m_pendingSegments.erase(segmentNo);
+    m_validatingSegments.insert(segmentNo);
+  }
+  afterSegmentReceived(data);
+
+  bool isCongestionMarked = false;
+  auto congestionMarkTag = data.getTag<lp::CongestionMarkTag>();
+  if (congestionMarkTag != nullptr && *congestionMarkTag > 0 && !m_options.ignoreCongestionMarks) {
+    isCongestionMarked = true;
+    decreaseWindow(isDiscovery, segmentNo);
+  }
+
+  weak_ptr<SegmentFetcher> weakSelf = m_this;
+  m_validator->validate(data,
+    [=] (const shared_ptr<const Data>& validatedData) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->afterWindowedValidationSuccess(*validatedData, isDiscovery, segmentNo,
+                                             isCongestionMarked);
+      }
+    },
+    [=] (const shared_ptr<const Data>&, const std::string&) {
+      auto self = weakSelf.lock();
+      if (self != nullptr) {
+        self->signalError(SEGMENT_VALIDATION_FAIL, "Segment validation fail");
+      }
+    });
+}
+
+void
+SegmentFetcher::afterWindowedValidationSuccess(const Data& data, bool isDiscovery,
+                                               uint64_t requestedSegmentNo, bool isCongestionMarked)
+{
+  if (m_isStopped) {
+    return;
+  }
+
+  if (!isDiscovery) {
+    m_validatingSegments.erase(requestedSegmentNo);
+  }
+
+  const name::Component& currentSegment = data.getName().get(-1);
+  if (!currentSegment.isSegment()) {
+    return signalError(DATA_HAS_NO_SEGMENT, "Data Name has no segment number.");
+  }
+  uint64_t segmentNo = currentSegment.toSegment();
+
+  if (isDiscovery) {
+    m_versionedName = data.getName().getPrefix(-1);
+  }
+
+  afterSegmentValidated(data);
+  if (!isCongestionMarked) {
+    increaseWindow();
+  }
+
+  const name::Component& finalBlockId = data.getMetaInfo().getFinalBlockId();
+  if (!finalBlockId.empty() && finalBlockId.isSegment()) {
+    m_nSegments = finalBlockId.toSegment() + 1;
+
+    // Interests beyond the last segment will never be satisfied
+    for (auto it = m_pendingSegments.lower_bound(*m_nSegments); it != m_pendingSegments.end(); ) {
+      m_face.removePendingInterest(it->second.pendingInterestId);
+      it = m_pendingSegments.erase(it);
+    }
+    m_retxQueue.erase(m_retxQueue.lower_bound(*m_nSegments), m_retxQueue.end());
+    m_outOfOrderSegments.erase(m_outOfOrderSegments.lower_bound(*m_nSegments),
+                               m_outOfOrderSegments.end());
+  }
+
+  if (segmentNo >= m_nDeliveredSegments && (!m_nSegments || segmentNo < *m_nSegments)) {
+    m_outOfOrderSegments.emplace(segmentNo, data.getContent());
+    m_retxQueue.erase(segmentNo);
+    auto pending = m_pendingSegments.find(segmentNo);
+    if (pending != m_pendingSegments.end()) {
+      m_face.removePendingInterest(pending->second.pendingInterestId);
+      m_pendingSegments.erase(pending);
+    }
+  }
+
+  size_t nDeliveredBefore = m_nDeliveredSegments;
+  for (auto it = m_outOfOrderSegments.begin();
+       it != m_outOfOrderSegments.end() && it->first == m_nDeliveredSegments;
+       it = m_outOfOrderSegments.erase(it)) {
+    m_buffer->write(reinterpret_cast<const char*>(it->second.value()), it->second.value_size());
+    m_nDeliveredBytes += it->second.value_size();
+    ++m_nDeliveredSegments;
+  }
+  if (m_nDeliveredSegments > nDeliveredBefore) {
+    onProgress(m_nDeliveredSegments, m_nDeliveredBytes);
+  }
+
+  if (m_nSegments && m_nDeliveredSegments >= *m_nSegments) {
+    shared_ptr<SegmentFetcher> self = m_this;
+    stop();
+    onComplete(m_buffer->buf());
+    return;
+  }
+
+  fillWindow();
+}
+
+void
+SegmentFetcher::afterWindowedNackReceived(const lp::Nack& nack, bool isDiscovery,
+                                          uint64_t segmentNo, uint32_t nRetransmissions)
+{
+  if (m_isStopped) {
+    return;
+  }
+
+  if (!isDiscovery && m_pendingSegments.erase(segmentNo) == 0) {
+    return; // segment has been received through another Interest
+  }
+  afterSegmentNacked();
+
+  switch (nack.getReason()) {
+    case lp::NackReason::DUPLICATE:
+      retransmit(isDiscovery, segmentNo, nRetransmissions, NACK_ERROR, "Nack Error");
+      break;
+    case lp::NackReason::CONGESTION:
+      decreaseWindow(isDiscovery, segmentNo);
+      if (nRetransmissions >= m_options.maxRetransmissions) {
+        return signalError(NACK_ERROR, "Nack Error");
+      }
+      // back off as fetch() does; stop() cancels the delayed retransmission
+      m_scheduler.scheduleEvent(getCongestionBackoff(nRetransmissions),
+                                bind(&SegmentFetcher::retransmit, this, isDiscovery, segmentNo,
+                                     nRetransmissions, NACK_ERROR, "Nack Error"));
+      break;
+    default:
+      signalError(NACK_ERROR, "Nack Error");
+      break;
+  }
+}
+
+void
+SegmentFetcher::afterWindowedTimeout(bool isDiscovery, uint64_t segmentNo,
+                                     uint32_t nRetransmissions)
+{
+  if (m_isStopped) {
+    return;
+  }
+
+  if (!isDiscovery && m_pendingSegments.erase(segmentNo) == 0) {
+    return; // segment has been received through another Interest
+  }
+  afterSegmentTimedOut();
+
+  decreaseWindow(isDiscovery, segmentNo);
+  retransmit(isDiscovery, segmentNo, nRetransmissions, INTEREST_TIMEOUT, "Timeout");
+}
+
+void
+SegmentFetcher::retransmit(bool isDiscovery, uint64_t segmentNo, uint32_t nRetransmissions,
+                           uint32_t errorCode, const std::string& errorMsg)
+{
+  if (nRetransmissions >= m_options.maxRetransmissions) {
+    return signalError(errorCode, errorMsg);
+  }
+
+  if (isDiscovery) {
+    expressDiscoveryInterest(nRetransmissions + 1);
+    return;
+  }
+
+  if (m_nSegments && segmentNo >= *m_nSegments) {
+    return; // the last segment has become known while the retransmission was delayed
+  }
+  m_retxQueue[segmentNo] = nRetransmissions + 1;
+  fillWindow();
+}
+
+void
+SegmentFetcher::increaseWindow()
+{
+  if (m_options.useConstantWindow) {
+    return;
+  }
+  m_cwnd = std::min(m_options.maxWindow, m_cwnd + m_options.aiStep / std::floor(m_cwnd));
+}
+
+void
+SegmentFetcher::decreaseWindow(bool isDiscovery, uint64_t segmentNo)
+{
+  if (m_options.useConstantWindow) {
+    return;
+  }
+
+  // react at most once per window: losses of segments requested before the previous
+  // decrease belong to the same congestion event
+  if (!isDiscovery && segmentNo < m_recoveryPoint) {
+    return;
+  }
+  m_cwnd = std::max(1.0, m_cwnd * m_options.mdCoef);
+  m_recoveryPoint = m_nextSegmentNo;
+}
+
+void
+SegmentFetcher::signalError(uint32_t code, const std::string& msg)
+{
+  shared_ptr<SegmentFetcher> self = m_this;
+  stop();
+  onError(code, msg);
+}
+
+void
+SegmentFetcher::cancelPendingInterests()
+{
+  if (m_discoveryInterestId != nullptr) {
+    m_face.removePendingInterest(m_discoveryInterestId);
+    m_discoveryInterestId = nullptr;
+  }
+  for (const auto& pending : m_pendingSegments) {
+    m_face.removePendingInterest(pending.second.pendingInterestId);
+  }
+  m_pendingSegments.clear();
+  m_retxQueue.clear();
+  m_scheduler.cancelAllEvents(); // delayed retransmissions
+}
+
 } // namespace util
 } // namespace ndn
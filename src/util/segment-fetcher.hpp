@@ -23,10 +23,14 @@
 #define NDN_UTIL_SEGMENT_FETCHER_HPP
 
 #include "scheduler.hpp"
+#include "signal.hpp"
 #include "../common.hpp"
 #include "../face.hpp"
 #include "../security/validator.hpp"
 
+#include <map>
+#include <set>
+
 namespace ndn {
 
 class OBufferStream;
@@ -97,6 +101,27 @@ namespace util {
  *                           bind(&afterFetchComplete, this, _1),
  *                           bind(&afterFetchError, this, _1, _2));
  *
+ * The fetch() functions implement the stop-and-wait procedure above: Interest for segment N+1
+ * is expressed only after segment N has been validated.  SegmentFetcher::start() instead
+ * keeps a window of segment Interests in flight (see SegmentFetcher::Options):
+ *
+ * - after the version is discovered, Interests are expressed for the lowest segment numbers
+ *   that are neither received nor in flight, until the window is full;
+ * - segments validated out of order are buffered and appended to the output in order;
+ * - a segment whose Interest times out or is Nacked with reason Duplicate or Congestion is
+ *   retransmitted, up to Options::maxRetransmissions times; after a Congestion Nack, the
+ *   retransmission is delayed by the same exponential backoff as in fetch();
+ * - in AIMD mode, the window grows by Options::aiStep per window of validated segments, and
+ *   is multiplied by Options::mdCoef (at most once per window) upon a timeout, a Congestion
+ *   Nack, or a Data carrying a congestion mark (CongestionMarkTag).
+ *
+ * Results and progress are reported through signals of the returned SegmentFetcher.  These
+ * signals, including the per-segment ones, are emitted only by a fetcher created with start();
+ * the fetch() functions report only through their callbacks:
+ *
+ *     auto fetcher = SegmentFetcher::start(face, Interest("/data/prefix"), validator, options);
+ *     fetcher->onComplete.connect(bind(&afterFetchComplete, this, _1));
+ *     fetcher->onError.connect(bind(&afterFetchError, this, _1, _2));
  */
 class SegmentFetcher : noncopyable
 {
@@ -119,6 +144,34 @@ public:
     NACK_ERROR = 4
   };
 
+  /**
+   * @brief Options of windowed segment fetching
+   * @sa start
+   */
+  class Options
+  {
+  public:
+    Options()
+    {
+    }
+
+  public:
+    /// @brief if true, the window stays at initialWindow; otherwise AIMD is used
+    bool useConstantWindow = false;
+    /// @brief initial window size, in segments
+    double initialWindow = 1.0;
+    /// @brief upper bound of the window size, in segments
+    double maxWindow = 256.0;
+    /// @brief additive increase step, in segments per window
+    double aiStep = 1.0;
+    /// @brief multiplicative decrease coefficient
+    double mdCoef = 0.5;
+    /// @brief if true, congestion marks on received Data do not shrink the window
+    bool ignoreCongestionMarks = false;
+    /// @brief maximum number of retransmissions of a single segment Interest
+    uint32_t maxRetransmissions = MAX_INTEREST_REEXPRESS;
+  };
+
   /**
    * @brief Initiate segment fetching
    *
@@ -167,12 +220,52 @@ public:
         const CompleteCallback& completeCallback,
         const ErrorCallback& errorCallback);
 
+  /**
+   * @brief Initiate windowed segment fetching
+   *
+   * @param face          Reference to the Face that should be used to fetch data
+   * @param baseInterest  An Interest for the initial segment of requested data, with the same
+   *                      meaning as in fetch()
+   * @param validator     A shared_ptr to the Validator that should be used to validate data
+   * @param options       Window and retransmission options
+   *
+   * @return the fetcher, which stays alive until it completes, fails, or is stopped;
+   *         callers connect to its signals to obtain the result
+   */
+  static
+  shared_ptr<SegmentFetcher>
+  start(Face& face,
+        const Interest& baseInterest,
+        shared_ptr<Validator> validator,
+        const Options& options = Options());
+
+  /**
+   * @brief Stop a fetch started with start()
+   *
+   * Pending Interests are cancelled, and no signal will be emitted afterwards.
+   */
+  void
+  stop();
+
+  /**
+   * @return current window size, in segments
+   */
+  double
+  getWindowSize() const
+  {
+    return m_cwnd;
+  }
+
 private:
   SegmentFetcher(Face& face,
                  shared_ptr<Validator> validator,
                  const CompleteCallback& completeCallback,
                  const ErrorCallback& errorCallback);
 
+  SegmentFetcher(Face& face,
+                 shared_ptr<Validator> validator,
+                 const Options& options);
+
   void
   fetchFirstSegment(const Interest& baseInterest, shared_ptr<SegmentFetcher> self);
 
@@ -181,9 +274,9 @@ private:
                    shared_ptr<SegmentFetcher> self);
 
   void
-  afterSegmentReceived(const Interest& origInterest,
-                       const Data& data, bool isSegmentZeroExpected,
-                       shared_ptr<SegmentFetcher> self);
+  handleSegmentReceived(const Interest& origInterest,
+                        const Data& data, bool isSegmentZeroExpected,
+                        shared_ptr<SegmentFetcher> self);
   void
   afterValidationSuccess(const shared_ptr<const Data> data,
                          bool isSegmentZeroExpected,
@@ -201,6 +294,92 @@ private:
   reExpressInterest(Interest interest, uint32_t reExpressCount,
                     shared_ptr<SegmentFetcher> self);
 
+private: // windowed fetching
+  void
+  expressDiscoveryInterest(uint32_t nRetransmissions);
+
+  void
+  expressSegmentInterest(uint64_t segmentNo, uint32_t nRetransmissions);
+
+  void
+  fillWindow();
+
+  /*
+   * In the handlers below, @p isDiscovery indicates that the Interest was the version
+   * discovery Interest, in which case @p segmentNo is not meaningful.
+   */
+
+  void
+  afterWindowedDataReceived(const Data& data, bool isDiscovery, uint64_t segmentNo);
+
+  void
+  afterWindowedValidationSuccess(const Data& data, bool isDiscovery, uint64_t segmentNo,
+                                 bool isCongestionMarked);
+
+  void
+  afterWindowedNackReceived(const lp::Nack& nack, bool isDiscovery, uint64_t segmentNo,
+                            uint32_t nRetransmissions);
+
+  void
+  afterWindowedTimeout(bool isDiscovery, uint64_t segmentNo, uint32_t nRetransmissions);
+
+  /**
+   * @brief Schedule retransmission of a segment, or fail if the limit has been reached
+   */
+  void
+  retransmit(bool isDiscovery, uint64_t segmentNo, uint32_t nRetransmissions,
+             uint32_t errorCode, const std::string& errorMsg);
+
+  void
+  increaseWindow();
+
+  void
+  decreaseWindow(bool isDiscovery, uint64_t segmentNo);
+
+  void
+  signalError(uint32_t code, const std::string& msg);
+
+  void
+  cancelPendingInterests();
+
+public:
+  /**
+   * @brief Emitted when all segments have been fetched and validated (start() only)
+   */
+  Signal<SegmentFetcher, ConstBufferPtr> onComplete;
+
+  /**
+   * @brief Emitted when fetching fails (start() only)
+   */
+  Signal<SegmentFetcher, uint32_t, std::string> onError;
+
+  /**
+   * @brief Emitted whenever a Data packet is received, before validation (start() only)
+   */
+  Signal<SegmentFetcher, Data> afterSegmentReceived;
+
+  /**
+   * @brief Emitted whenever a Data packet is successfully validated (start() only)
+   */
+  Signal<SegmentFetcher, Data> afterSegmentValidated;
+
+  /**
+   * @brief Emitted whenever an Interest is Nacked (start() only)
+   */
+  Signal<SegmentFetcher> afterSegmentNacked;
+
+  /**
+   * @brief Emitted whenever an Interest times out (start() only)
+   */
+  Signal<SegmentFetcher> afterSegmentTimedOut;
+
+  /**
+   * @brief Emitted when the contiguous output grows (start() only)
+   *
+   * Arguments are the number of segments and the number of bytes appended to the output so far.
+   */
+  Signal<SegmentFetcher, uint64_t, size_t> onProgress;
+
 private:
   Face& m_face;
   Scheduler m_scheduler;
@@ -209,6 +388,30 @@ private:
   ErrorCallback m_errorCallback;
 
   shared_ptr<OBufferStream> m_buffer;
+
+  // windowed fetching state
+  struct PendingSegment
+  {
+    const PendingInterestId* pendingInterestId;
+    uint32_t nRetransmissions;
+  };
+
+  Options m_options;
+  shared_ptr<SegmentFetcher> m_this; ///< keeps a started fetcher alive until it finishes
+  bool m_isStopped;
+  Interest m_baseInterest;
+  Name m_versionedName;
+  double m_cwnd;
+  uint64_t m_nextSegmentNo;        ///< lowest segment number never requested
+  uint64_t m_nDeliveredSegments;   ///< segments before this one have been appended to output
+  size_t m_nDeliveredBytes;
+  optional<uint64_t> m_nSegments;  ///< known after Data with FinalBlockId is validated
+  uint64_t m_recoveryPoint;        ///< no window decrease for segments below this point
+  const PendingInterestId* m_discoveryInterestId;
+  std::map<uint64_t, PendingSegment> m_pendingSegments;
+  std::map<uint64_t, uint32_t> m_retxQueue; ///< segment number => retransmission count
+  std::set<uint64_t> m_validatingSegments;
+  std::map<uint64_t, Block> m_outOfOrderSegments;
 };
 
 } // namespace util
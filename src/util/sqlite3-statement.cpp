@@ -26,18 +26,67 @@
 namespace ndn {
 namespace util {
 
+Sqlite3StatementCache::Sqlite3StatementCache(sqlite3* database)
+  : m_database(database)
+{
+}
+
+Sqlite3StatementCache::~Sqlite3StatementCache()
+{
+  for (const auto& entry : m_idleStatements) {
+    for (sqlite3_stmt* stmt : entry.second) {
+      sqlite3_finalize(stmt);
+    }
+  }
+}
+
+size_t
+Sqlite3StatementCache::size() const
+{
+  size_t nStatements = 0;
+  for (const auto& entry : m_idleStatements) {
+    nStatements += entry.second.size();
+  }
+  return nStatements;
+}
+
 Sqlite3Statement::~Sqlite3Statement()
 {
-  sqlite3_finalize(m_stmt);
+  if (m_idleStatements == nullptr) {
+    sqlite3_finalize(m_stmt);
+    return;
+  }
+
+  // release the locks held by the statement and the buffers bound with SQLITE_STATIC
+  sqlite3_reset(m_stmt);
+  sqlite3_clear_bindings(m_stmt);
+  m_idleStatements->push_back(m_stmt);
 }
 
 Sqlite3Statement::Sqlite3Statement(sqlite3* database, const std::string& statement)
+  : m_idleStatements(nullptr)
 {
   int res = sqlite3_prepare_v2(database, statement.c_str(), -1, &m_stmt, nullptr);
   if (res != SQLITE_OK)
     BOOST_THROW_EXCEPTION(std::domain_error("bad SQL statement: " + statement));
 }
 
+Sqlite3Statement::Sqlite3Statement(Sqlite3StatementCache& cache, const std::string& statement)
+  : m_idleStatements(nullptr)
+{
+  auto& idleStatements = cache.m_idleStatements[statement];
+  if (idleStatements.empty()) {
+    int res = sqlite3_prepare_v2(cache.m_database, statement.c_str(), -1, &m_stmt, nullptr);
+    if (res != SQLITE_OK)
+      BOOST_THROW_EXCEPTION(std::domain_error("bad SQL statement: " + statement));
+  }
+  else {
+    m_stmt = idleStatements.back();
+    idleStatements.pop_back();
+  }
+  m_idleStatements = &idleStatements;
+}
+
 int
 Sqlite3Statement::bind(int index, const char* value, size_t size, void(*destructor)(void*))
 {
@@ -111,5 +160,31 @@ Sqlite3Statement::operator sqlite3_stmt*()
   return m_stmt;
 }
 
+Sqlite3Transaction::Sqlite3Transaction(sqlite3* database)
+  : m_database(database)
+  , m_isCommitted(false)
+{
+  if (sqlite3_exec(m_database, "SAVEPOINT ndn_transaction", nullptr, nullptr, nullptr) != SQLITE_OK)
+    BOOST_THROW_EXCEPTION(std::domain_error(std::string("cannot begin transaction: ") +
+                                            sqlite3_errmsg(m_database)));
+}
+
+Sqlite3Transaction::~Sqlite3Transaction()
+{
+  if (!m_isCommitted) {
+    sqlite3_exec(m_database, "ROLLBACK TO ndn_transaction", nullptr, nullptr, nullptr);
+    sqlite3_exec(m_database, "RELEASE ndn_transaction", nullptr, nullptr, nullptr);
+  }
+}
+
+void
+Sqlite3Transaction::commit()
+{
+  if (sqlite3_exec(m_database, "RELEASE ndn_transaction", nullptr, nullptr, nullptr) != SQLITE_OK)
+    BOOST_THROW_EXCEPTION(std::domain_error(std::string("cannot commit transaction: ") +
+                                            sqlite3_errmsg(m_database)));
+  m_isCommitted = true;
+}
+
 } // namespace util
 } // namespace ndn
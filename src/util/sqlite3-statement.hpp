@@ -23,7 +23,9 @@
 #define NDN_UTIL_SQLITE3_STATEMENT_HPP
 
 #include "../encoding/block.hpp"
+
 #include <string>
+#include <unordered_map>
 
 struct sqlite3;
 struct sqlite3_stmt;
@@ -31,6 +33,40 @@ struct sqlite3_stmt;
 namespace ndn {
 namespace util {
 
+class Sqlite3Statement;
+
+/**
+ * @brief keep prepared statements of an SQLite3 database connection for reuse
+ * @warning This class is implementation detail of ndn-cxx library.
+ *
+ * A Sqlite3Statement created from the cache takes an idle prepared statement with the same
+ * SQL, or prepares a new one, and gives it back to the cache when it is destructed.
+ */
+class Sqlite3StatementCache : noncopyable
+{
+public:
+  explicit
+  Sqlite3StatementCache(sqlite3* database);
+
+  /**
+   * @brief finalize all cached statements
+   * @pre no Sqlite3Statement created from this cache is alive
+   */
+  ~Sqlite3StatementCache();
+
+  /**
+   * @return number of idle prepared statements
+   */
+  size_t
+  size() const;
+
+private:
+  sqlite3* m_database;
+  std::unordered_map<std::string, std::vector<sqlite3_stmt*>> m_idleStatements;
+
+  friend class Sqlite3Statement;
+};
+
 /**
  * @brief wrap an SQLite3 prepared statement
  * @warning This class is implementation detail of ndn-cxx library.
@@ -47,7 +83,15 @@ public:
   Sqlite3Statement(sqlite3* database, const std::string& statement);
 
   /**
-   * @brief finalize the statement
+   * @brief take a prepared statement from @p cache, or prepare it if none is idle
+   * @param cache cache of the database connection, must outlive the statement
+   * @param statement SQL statement
+   * @throw std::domain_error SQL statement is bad
+   */
+  Sqlite3Statement(Sqlite3StatementCache& cache, const std::string& statement);
+
+  /**
+   * @brief finalize the statement, or reset it and give it back to the cache
    */
   ~Sqlite3Statement();
 
@@ -150,6 +194,41 @@ public:
 
 private:
   sqlite3_stmt* m_stmt;
+  std::vector<sqlite3_stmt*>* m_idleStatements;
+};
+
+/**
+ * @brief group the changes to an SQLite3 database into one transaction
+ * @warning This class is implementation detail of ndn-cxx library.
+ *
+ * The transaction is a savepoint, so that it can be nested in another transaction.  It is
+ * rolled back when destructed without commit(), e.g., when an exception is thrown.
+ */
+class Sqlite3Transaction : noncopyable
+{
+public:
+  /**
+   * @brief begin the transaction
+   * @throw std::domain_error the transaction cannot begin
+   */
+  explicit
+  Sqlite3Transaction(sqlite3* database);
+
+  /**
+   * @brief roll back the transaction unless it has been committed
+   */
+  ~Sqlite3Transaction();
+
+  /**
+   * @brief commit the transaction
+   * @throw std::domain_error the transaction cannot be committed
+   */
+  void
+  commit();
+
+private:
+  sqlite3* m_database;
+  bool m_isCommitted;
 };
 
 } // namespace util
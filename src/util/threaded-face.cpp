@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "threaded-face.hpp"
+#include "logger.hpp"
+
+namespace ndn {
+namespace util {
+
+NDN_LOG_INIT(ndn.util.ThreadedFace);
+
+ThreadedFace::ThreadedFace(const FaceCreator& createFace, const Executor& executor)
+  : m_work(new boost::asio::io_service::work(m_ioService))
+  , m_face(createFace != nullptr ? createFace(m_ioService) : make_unique<Face>(m_ioService))
+  , m_executor(executor)
+  , m_isDrainScheduled(false)
+  , m_lastHandle(0)
+{
+  BOOST_ASSERT(m_face != nullptr);
+  BOOST_ASSERT(&m_face->getIoService() == &m_ioService);
+
+  m_thread = std::thread(&ThreadedFace::run, this);
+}
+
+ThreadedFace::~ThreadedFace()
+{
+  if (std::this_thread::get_id() == m_thread.get_id()) {
+    // joining the I/O thread from itself would never return
+    NDN_LOG_FATAL("ThreadedFace must not be destroyed on its I/O thread");
+    BOOST_ASSERT_MSG(false, "ThreadedFace must not be destroyed on its I/O thread");
+    std::terminate();
+  }
+
+  // commands are executed in FIFO order, so this runs after all previously queued commands
+  this->enqueue([this] {
+    m_face->shutdown();
+    m_pendingInterests.clear();
+    m_interestFilters.clear();
+    m_work.reset();
+    // Face::shutdown posts its own work, which is processed before this handler
+    m_ioService.post([this] { m_ioService.stop(); });
+  });
+  m_thread.join();
+  m_face.reset();
+}
+
+ThreadedFace::PendingInterestHandle
+ThreadedFace::expressInterest(const Interest& interest,
+                              const DataCallback& afterSatisfied,
+                              const NackCallback& afterNacked,
+                              const TimeoutCallback& afterTimeout)
+{
+  interest.wireEncode(); // encode on the calling thread; copies share the encoding
+  DataCallback onData = this->wrap(afterSatisfied);
+  NackCallback onNack = this->wrap(afterNacked);
+  TimeoutCallback onTimeout = this->wrap(afterTimeout);
+  PendingInterestHandle handle = ++m_lastHandle;
+
+  this->enqueue([=] {
+    // the handle is forgotten when the Interest is satisfied, nacked, or timed out
+    m_pendingInterests[handle] = m_face->expressInterest(interest,
+      [this, handle, onData] (const Interest& interest, const Data& data) {
+        m_pendingInterests.erase(handle);
+        if (onData != nullptr) {
+          onData(interest, data);
+        }
+      },
+      [this, handle, onNack] (const Interest& interest, const lp::Nack& nack) {
+        m_pendingInterests.erase(handle);
+        if (onNack != nullptr) {
+          onNack(interest, nack);
+        }
+      },
+      [this, handle, onTimeout] (const Interest& interest) {
+        m_pendingInterests.erase(handle);
+        if (onTimeout != nullptr) {
+          onTimeout(interest);
+        }
+      });
+  });
+
+  return handle;
+}
+
+void
+ThreadedFace::removePendingInterest(PendingInterestHandle handle)
+{
+  this->enqueue([this, handle] {
+    auto it = m_pendingInterests.find(handle);
+    if (it != m_pendingInterests.end()) {
+      m_face->removePendingInterest(it->second);
+      m_pendingInterests.erase(it);
+    }
+  });
+}
+
+void
+ThreadedFace::put(const Data& data)
+{
+  data.wireEncode();
+  this->enqueue([this, data] { m_face->put(data); });
+}
+
+void
+ThreadedFace::put(const lp::Nack& nack)
+{
+  nack.getInterest().wireEncode();
+  this->enqueue([this, nack] { m_face->put(nack); });
+}
+
+ThreadedFace::InterestFilterHandle
+ThreadedFace::setInterestFilter(const InterestFilter& interestFilter,
+                                const InterestCallback& onInterest,
+                                const RegisterPrefixFailureCallback& onFailure,
+                                const security::SigningInfo& signingInfo,
+                                uint64_t flags)
+{
+  InterestCallback onInterestWrapped = this->wrap(onInterest);
+  RegisterPrefixFailureCallback onFailureWrapped = this->wrap(onFailure);
+  InterestFilterHandle handle = ++m_lastHandle;
+
+  this->enqueue([=] {
+    const RegisteredPrefixId* id = m_face->setInterestFilter(interestFilter, onInterestWrapped,
+                                                             onFailureWrapped, signingInfo, flags);
+    m_interestFilters[handle] = [this, id] { m_face->unsetInterestFilter(id); };
+  });
+
+  return handle;
+}
+
+ThreadedFace::InterestFilterHandle
+ThreadedFace::setInterestFilter(const InterestFilter& interestFilter,
+                                const InterestCallback& onInterest)
+{
+  InterestCallback onInterestWrapped = this->wrap(onInterest);
+  InterestFilterHandle handle = ++m_lastHandle;
+
+  this->enqueue([=] {
+    const InterestFilterId* id = m_face->setInterestFilter(interestFilter, onInterestWrapped);
+    m_interestFilters[handle] = [this, id] { m_face->unsetInterestFilter(id); };
+  });
+
+  return handle;
+}
+
+void
+ThreadedFace::unsetInterestFilter(InterestFilterHandle handle)
+{
+  this->enqueue([this, handle] {
+    auto it = m_interestFilters.find(handle);
+    if (it != m_interestFilters.end()) {
+      it->second();
+      m_interestFilters.erase(it);
+    }
+  });
+}
+
+void
+ThreadedFace::enqueue(Command command)
+{
+  m_commands.push(std::move(command));
+
+  // At most one drain is outstanding; it resets the flag before taking commands, so a
+  // command pushed after the last pop of that drain schedules another one.
+  if (!m_isDrainScheduled.exchange(true)) {
+    m_ioService.post([this] { this->drain(); });
+  }
+}
+
+void
+ThreadedFace::drain()
+{
+  // a read-modify-write joins the release sequence of the producers' exchange(true), so the
+  // commands pushed before a producer saw the flag set are visible to the pops below
+  m_isDrainScheduled.exchange(false, std::memory_order_acq_rel);
+
+  Command command;
+  while (m_commands.pop(command)) {
+    try {
+      command();
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_ERROR("command failed: " << e.what());
+    }
+  }
+}
+
+template<typename... Args>
+function<void(const Args&...)>
+ThreadedFace::wrap(const function<void(const Args&...)>& callback) const
+{
+  if (callback == nullptr || m_executor == nullptr) {
+    return callback;
+  }
+
+  Executor executor = m_executor;
+  return [executor, callback] (const Args&... args) {
+    executor([=] { callback(args...); });
+  };
+}
+
+void
+ThreadedFace::run()
+{
+  while (true) {
+    try {
+      m_ioService.run();
+      return;
+    }
+    catch (const std::exception& e) {
+      // e.g., the connection to the forwarder is lost; the io_service can continue to run
+      NDN_LOG_ERROR("I/O thread: " << e.what());
+    }
+  }
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_THREADED_FACE_HPP
+#define NDN_UTIL_THREADED_FACE_HPP
+
+#include "../face.hpp"
+#include "detail/mpsc-queue.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+namespace ndn {
+namespace util {
+
+/** \brief a Face that runs on its own I/O thread, and can be used from any thread
+ *
+ *  ThreadedFace owns an io_service and a Face created on that io_service, and runs the
+ *  io_service on an internal thread.  expressInterest, put, and setInterestFilter may be
+ *  invoked concurrently from any number of threads: each call is appended to a lock-free
+ *  command queue, which the I/O thread drains in a batch.  Packets are encoded by the calling
+ *  thread; the I/O thread only performs the Face operations.
+ *
+ *  Callbacks are passed to an Executor, which decides on which thread they run.  Without
+ *  an Executor, callbacks are invoked directly on the I/O thread, and therefore must not block.
+ *
+ *  \code
+ *  boost::asio::io_service workers; // run by a pool of worker threads
+ *  ThreadedFace face(nullptr, [&workers] (const function<void()>& f) { workers.post(f); });
+ *  face.expressInterest(interest, onData, onNack, onTimeout); // from any worker thread
+ *  \endcode
+ */
+class ThreadedFace : noncopyable
+{
+public:
+  /** \brief invokes a callback, usually by scheduling it on some thread
+   */
+  typedef function<void(const function<void()>& callback)> Executor;
+
+  /** \brief creates the Face on the io_service of the ThreadedFace
+   */
+  typedef function<unique_ptr<Face>(boost::asio::io_service& ioService)> FaceCreator;
+
+  /** \brief identifies an Interest expressed through ThreadedFace
+   *
+   *  Handles are allocated on the calling thread, before the Interest is expressed on the
+   *  I/O thread.  Zero is never a valid handle.
+   */
+  typedef uint64_t PendingInterestHandle;
+
+  /** \brief identifies an InterestFilter set through ThreadedFace
+   *
+   *  Handles are allocated on the calling thread, before the InterestFilter is set on the
+   *  I/O thread.  Zero is never a valid handle.
+   */
+  typedef uint64_t InterestFilterHandle;
+
+  /** \brief create the Face with \p createFace, and start the I/O thread
+   *  \param createFace creates the Face; if empty, Face is created with default transport
+   *                    and KeyChain
+   *  \param executor invokes the callbacks; if empty, callbacks run on the I/O thread
+   */
+  explicit
+  ThreadedFace(const FaceCreator& createFace = nullptr, const Executor& executor = nullptr);
+
+  /** \brief shut down the Face and join the I/O thread
+   *
+   *  Commands queued before the destructor is invoked are executed before the Face is shut down.
+   *  \warning must not be invoked from the I/O thread, e.g., from a callback invoked without
+   *           an Executor; doing so is detected and terminates the program
+   */
+  ~ThreadedFace();
+
+  /** \brief express Interest
+   *  \note thread-safe
+   *  \return a handle that can be passed to removePendingInterest
+   *  \sa Face::expressInterest
+   */
+  PendingInterestHandle
+  expressInterest(const Interest& interest,
+                  const DataCallback& afterSatisfied,
+                  const NackCallback& afterNacked,
+                  const TimeoutCallback& afterTimeout);
+
+  /** \brief cancel an Interest expressed through expressInterest
+   *
+   *  None of the callbacks of the Interest are invoked after the cancellation takes effect on
+   *  the I/O thread.  Callbacks already passed to the Executor are not affected.
+   *  \note thread-safe
+   *  \sa Face::removePendingInterest
+   */
+  void
+  removePendingInterest(PendingInterestHandle handle);
+
+  /** \brief publish a Data packet
+   *  \note thread-safe
+   *  \sa Face::put
+   */
+  void
+  put(const Data& data);
+
+  /** \brief send a Nack
+   *  \note thread-safe
+   *  \sa Face::put
+   */
+  void
+  put(const lp::Nack& nack);
+
+  /** \brief set InterestFilter to dispatch matching incoming Interests to \p onInterest,
+   *         and register the prefix with the forwarder
+   *  \note thread-safe
+   *  \return a handle that can be passed to unsetInterestFilter
+   *  \sa Face::setInterestFilter
+   */
+  InterestFilterHandle
+  setInterestFilter(const InterestFilter& interestFilter,
+                    const InterestCallback& onInterest,
+                    const RegisterPrefixFailureCallback& onFailure,
+                    const security::SigningInfo& signingInfo = security::SigningInfo(),
+                    uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
+
+  /** \brief set InterestFilter to dispatch matching incoming Interests to \p onInterest,
+   *         without registering the prefix
+   *  \note thread-safe
+   *  \return a handle that can be passed to unsetInterestFilter
+   *  \sa Face::setInterestFilter
+   */
+  InterestFilterHandle
+  setInterestFilter(const InterestFilter& interestFilter,
+                    const InterestCallback& onInterest);
+
+  /** \brief unset an InterestFilter set through setInterestFilter, and unregister its prefix
+   *         if it was registered
+   *  \note thread-safe
+   *  \sa Face::unsetInterestFilter
+   */
+  void
+  unsetInterestFilter(InterestFilterHandle handle);
+
+  /** \return the underlying Face
+   *  \warning The Face must only be accessed on the I/O thread, e.g., in a callback invoked
+   *           without an Executor.
+   */
+  Face&
+  getFace()
+  {
+    return *m_face;
+  }
+
+private:
+  typedef function<void()> Command;
+
+  /** \brief append \p command to the command queue, and wake up the I/O thread if needed
+   */
+  void
+  enqueue(Command command);
+
+  /** \brief execute all queued commands
+   *  \note runs on the I/O thread
+   */
+  void
+  drain();
+
+  /** \brief wrap \p callback so that it is invoked through the executor
+   */
+  template<typename... Args>
+  function<void(const Args&...)>
+  wrap(const function<void(const Args&...)>& callback) const;
+
+  void
+  run();
+
+private:
+  boost::asio::io_service m_ioService;
+  unique_ptr<boost::asio::io_service::work> m_work;
+  unique_ptr<Face> m_face;
+  Executor m_executor;
+
+  detail::MpscQueue<Command> m_commands;
+  std::atomic<bool> m_isDrainScheduled;
+  std::atomic<uint64_t> m_lastHandle;
+
+  // accessed on the I/O thread only
+  std::unordered_map<PendingInterestHandle, const PendingInterestId*> m_pendingInterests;
+  std::unordered_map<InterestFilterHandle, function<void()>> m_interestFilters;
+
+  std::thread m_thread;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_THREADED_FACE_HPP
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx CertificateCache Benchmark
+
+#include "security/v2/certificate-cache.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+static Name
+makeKeyName(size_t i)
+{
+  return Name("/bench/certificate-cache").appendNumber(i).append("KEY").appendNumber(i);
+}
+
+static Name
+makeCertName(size_t i)
+{
+  return Name(makeKeyName(i)).append("issuer").appendVersion(1);
+}
+
+BOOST_AUTO_TEST_CASE(Find)
+{
+  const size_t nCerts = 100000;
+  const size_t nLookups = 100000;
+
+  // certificates carry a fake signature
+  CertificateCache cache;
+  auto now = time::system_clock::now();
+  const uint8_t keyBits[] = {0x01, 0x02, 0x03, 0x04};
+  for (size_t i = 0; i < nCerts; ++i) {
+    Data data(makeCertName(i));
+    data.setContentType(tlv::ContentType_Key);
+    data.setFreshnessPeriod(time::hours(1));
+    data.setContent(keyBits, sizeof(keyBits));
+
+    SignatureInfo info(tlv::SignatureSha256WithEcdsa, KeyLocator(makeKeyName(i)));
+    info.setValidityPeriod(ValidityPeriod(now - time::days(1), now + time::days(1)));
+    Signature signature(info);
+    signature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+    data.setSignature(signature);
+    data.wireEncode();
+
+    cache.insert(Certificate(std::move(data)));
+  }
+
+  std::vector<Name> certNames;
+  std::vector<Name> keyNames;
+  std::vector<Interest> interests;
+  for (size_t i = 0; i < nLookups; ++i) {
+    // spread the lookups over the whole cache
+    size_t cert = (i * 7919) % nCerts;
+
+    certNames.push_back(makeCertName(cert));
+    keyNames.push_back(makeKeyName(cert));
+    interests.emplace_back(makeKeyName(cert));
+  }
+
+  size_t nFoundByCertName = 0;
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (const Name& name : certNames) {
+    nFoundByCertName += cache.find(name) != nullptr;
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  size_t nFoundByKeyName = 0;
+  for (const Name& name : keyNames) {
+    nFoundByKeyName += cache.find(name) != nullptr;
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+  size_t nFoundByInterest = 0;
+  for (const Interest& interest : interests) {
+    nFoundByInterest += cache.find(interest) != nullptr;
+  }
+  time::steady_clock::TimePoint t4 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nFoundByCertName, nLookups);
+  BOOST_CHECK_EQUAL(nFoundByKeyName, nLookups);
+  BOOST_CHECK_EQUAL(nFoundByInterest, nLookups);
+  BOOST_TEST_MESSAGE("certificate name: " << nLookups << " lookups in " << nCerts << " certificates: " <<
+                     (t2 - t1) << ", " << (t2 - t1) / nLookups << " per lookup");
+  BOOST_TEST_MESSAGE("key name: " << nLookups << " lookups in " << nCerts << " certificates: " <<
+                     (t3 - t2) << ", " << (t3 - t2) / nLookups << " per lookup");
+  BOOST_TEST_MESSAGE("Interest for key name: " << nLookups << " lookups in " << nCerts << " certificates: " <<
+                     (t4 - t3) << ", " << (t4 - t3) / nLookups << " per lookup");
+}
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Decode Benchmark
+
+#include "data.hpp"
+#include "interest.hpp"
+#include "security/signature-sha256-with-ecdsa.hpp"
+
+#include "boost-test.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> g_nAllocations(0);
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size != 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(DecodeInterest)
+{
+  const size_t nDecodes = 200000;
+  Interest interest("/ndn/edu/ucla/cs/irl/video/seg/%00%01");
+  interest.setNonce(1);
+  interest.setInterestLifetime(time::seconds(2));
+  interest.setMustBeFresh(true);
+  const Block& wire = interest.wireEncode();
+
+  // decode from a fresh copy of the wire, so that no parsed elements are shared across iterations
+  Block input(wire.wire(), wire.size());
+
+  size_t nAllocations = g_nAllocations;
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nDecodes; ++i) {
+    Interest decoded(input);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  nAllocations = g_nAllocations - nAllocations;
+
+  BOOST_CHECK(Interest(input).wireEncode() == wire);
+  BOOST_TEST_MESSAGE("Interest: " << nDecodes << " decodes: " << (t2 - t1) << ", " <<
+                     time::duration_cast<time::nanoseconds>(t2 - t1).count() / nDecodes <<
+                     " ns/decode, " << static_cast<double>(nAllocations) / nDecodes <<
+                     " allocations/decode");
+}
+
+BOOST_AUTO_TEST_CASE(DecodeData)
+{
+  const size_t nDecodes = 200000;
+  Data data("/ndn/edu/ucla/cs/irl/video/seg/%00%01");
+  data.setFreshnessPeriod(time::seconds(1));
+  std::vector<uint8_t> content(100, 0xaa);
+  data.setContent(content.data(), content.size());
+
+  SignatureSha256WithEcdsa signature(KeyLocator(Name("/ndn/edu/ucla/KEY/%01%02")));
+  signature.setValue(makeBinaryBlock(tlv::SignatureValue, content.data(), 64));
+  data.setSignature(signature);
+  const Block& wire = data.wireEncode();
+
+  // decode from a fresh copy of the wire, so that no parsed elements are shared across iterations
+  Block input(wire.wire(), wire.size());
+
+  size_t nAllocations = g_nAllocations;
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nDecodes; ++i) {
+    Data decoded(input);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  nAllocations = g_nAllocations - nAllocations;
+
+  BOOST_CHECK(Data(input).wireEncode() == wire);
+  BOOST_TEST_MESSAGE("Data: " << nDecodes << " decodes: " << (t2 - t1) << ", " <<
+                     time::duration_cast<time::nanoseconds>(t2 - t1).count() / nDecodes <<
+                     " ns/decode, " << static_cast<double>(nAllocations) / nDecodes <<
+                     " allocations/decode");
+}
+
+} // namespace tests
+} // namespace ndn
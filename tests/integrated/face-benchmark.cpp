@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face Benchmark
+
+#include "util/dummy-client-face.hpp"
+#include "lp/tags.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "identity-management-fixture.hpp"
+#include "boost-test.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace tests {
+
+using util::DummyClientFace;
+
+static shared_ptr<Data>
+makeData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+  data->setSignature(fakeSignature);
+  data->wireEncode();
+  return data;
+}
+
+BOOST_FIXTURE_TEST_SUITE(FaceBenchmark, IdentityManagementV1Fixture)
+
+BOOST_AUTO_TEST_CASE(SatisfyPendingInterests)
+{
+  boost::asio::io_service io;
+  DummyClientFace face(io, m_keyChain, {false, false});
+
+  const size_t nData = 10000;
+  std::vector<shared_ptr<Data>> dataPackets;
+  for (size_t i = 0; i < nData; ++i) {
+    dataPackets.push_back(makeData(Name("/bench/data").appendSequenceNumber(i).append("payload")));
+  }
+
+  for (size_t pitSize : {1000, 10000, 100000}) {
+    size_t nSatisfied = 0;
+    for (size_t i = 0; i < pitSize; ++i) {
+      face.expressInterest(Interest(Name("/bench/data").appendSequenceNumber(i), time::seconds(60)),
+                           [&] (const Interest&, const Data&) { ++nSatisfied; },
+                           nullptr, nullptr);
+    }
+    io.poll();
+    io.reset();
+    BOOST_REQUIRE_EQUAL(face.getNPendingInterests(), pitSize);
+
+    // each Data packet satisfies at most one pending Interest
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (size_t i = 0; i < nData; ++i) {
+      face.receive(*dataPackets[i]);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nSatisfied, std::min(pitSize, nData));
+    BOOST_TEST_MESSAGE("PIT size " << pitSize << ": receive " << nData << " Data: " << (t2 - t1) <<
+                       ", " << (t2 - t1) / nData << " per packet");
+
+    face.removeAllPendingInterests();
+    io.poll();
+    io.reset();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NackPendingInterests)
+{
+  boost::asio::io_service io;
+  DummyClientFace face(io, m_keyChain, {false, false});
+
+  const size_t nNacks = 10000;
+
+  for (size_t pitSize : {1000, 10000, 100000}) {
+    size_t nNacked = 0;
+    std::vector<lp::Nack> nacks;
+    for (size_t i = 0; i < pitSize; ++i) {
+      Interest interest(Name("/bench/nack").appendSequenceNumber(i), time::seconds(60));
+      interest.setNonce(static_cast<uint32_t>(i + 1));
+      face.expressInterest(interest, nullptr,
+                           [&] (const Interest&, const lp::Nack&) { ++nNacked; },
+                           nullptr);
+      if (i < nNacks) {
+        lp::Nack nack(interest);
+        nack.setReason(lp::NackReason::NO_ROUTE);
+        nacks.push_back(nack);
+      }
+    }
+    io.poll();
+    io.reset();
+
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (const auto& nack : nacks) {
+      face.receive(nack);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nNacked, nacks.size());
+    BOOST_TEST_MESSAGE("PIT size " << pitSize << ": receive " << nacks.size() << " Nacks: " <<
+                       (t2 - t1) << ", " << (t2 - t1) / nacks.size() << " per packet");
+
+    face.removeAllPendingInterests();
+    io.poll();
+    io.reset();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DispatchInterestFilters)
+{
+  boost::asio::io_service io;
+  DummyClientFace face(io, m_keyChain, {false, false});
+
+  const size_t nInterests = 10000;
+
+  for (size_t nFilters : {100, 1000, 10000}) {
+    size_t nDispatched = 0;
+    std::vector<const InterestFilterId*> filterIds;
+    for (size_t i = 0; i < nFilters; ++i) {
+      // resembles mgmt::Dispatcher, which sets one filter per handler per top prefix
+      Name prefix = Name("/bench/filter").appendNumber(i % 10).append("handler").appendNumber(i);
+      filterIds.push_back(face.setInterestFilter(prefix,
+        [&] (const InterestFilter&, const Interest&) { ++nDispatched; }));
+    }
+    filterIds.push_back(face.setInterestFilter(InterestFilter("/bench/filter", "<><handler><><regex>"),
+      [&] (const InterestFilter&, const Interest&) { ++nDispatched; }));
+    io.poll();
+    io.reset();
+
+    std::vector<Interest> interests;
+    for (size_t i = 0; i < nInterests; ++i) {
+      size_t handler = i % nFilters;
+      interests.emplace_back(Name("/bench/filter").appendNumber(handler % 10).append("handler")
+                             .appendNumber(handler).appendSequenceNumber(i));
+    }
+
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (const auto& interest : interests) {
+      face.receive(interest);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nDispatched, nInterests);
+    BOOST_TEST_MESSAGE(nFilters << " filters: receive " << nInterests << " Interests: " <<
+                       (t2 - t1) << ", " << (t2 - t1) / nInterests << " per packet");
+
+    for (const InterestFilterId* filterId : filterIds) {
+      face.unsetInterestFilter(filterId);
+    }
+    io.poll();
+    io.reset();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DecodeIncomingPackets)
+{
+  boost::asio::io_service io;
+  DummyClientFace face(io, m_keyChain, {false, false});
+
+  const size_t nPackets = 100000;
+
+  // Data with content, so that the cost of decoding beyond the Name is visible
+  std::vector<shared_ptr<Data>> bareData;
+  std::vector<shared_ptr<Data>> lpData;
+  const std::vector<uint8_t> content(1024, 0xDD);
+  for (size_t i = 0; i < nPackets; ++i) {
+    auto data = make_shared<Data>(Name("/bench/decode").appendSequenceNumber(i));
+    data->setFreshnessPeriod(time::seconds(1));
+    data->setContent(content.data(), content.size());
+    SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    bareData.push_back(data);
+
+    // a CongestionMark forces NDNLPv2 encapsulation
+    auto taggedData = make_shared<Data>(*data);
+    taggedData->setTag(make_shared<lp::CongestionMarkTag>(1));
+    lpData.push_back(taggedData);
+  }
+
+  std::vector<Interest> interests;
+  for (size_t i = 0; i < nPackets; ++i) {
+    interests.emplace_back(Name("/bench/decode").appendSequenceNumber(i), time::seconds(60));
+    interests.back().setNonce(static_cast<uint32_t>(i + 1));
+    interests.back().wireEncode();
+  }
+
+  // every Data satisfies a pending Interest, so that both Data paths decode the whole packet
+  size_t nSatisfied = 0;
+  auto expressInterests = [&] {
+    for (const auto& interest : interests) {
+      face.expressInterest(interest, [&] (const Interest&, const Data&) { ++nSatisfied; },
+                           nullptr, nullptr);
+    }
+    io.poll();
+    io.reset();
+    BOOST_REQUIRE_EQUAL(face.getNPendingInterests(), nPackets);
+  };
+
+  expressInterests();
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nPackets; ++i) {
+    face.receive(*bareData[i]);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nSatisfied, nPackets);
+
+  expressInterests();
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+  for (size_t i = 0; i < nPackets; ++i) {
+    face.receive(*lpData[i]);
+  }
+  time::steady_clock::TimePoint t4 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nSatisfied, 2 * nPackets);
+
+  // no InterestFilter is set, so each Interest is decoded and then dropped
+  time::steady_clock::TimePoint t5 = time::steady_clock::now();
+  for (size_t i = 0; i < nPackets; ++i) {
+    face.receive(interests[i]);
+  }
+  time::steady_clock::TimePoint t6 = time::steady_clock::now();
+
+  auto packetsPerSecond = [nPackets] (const time::nanoseconds& duration) {
+    return static_cast<uint64_t>(nPackets / time::duration_cast<time::duration<double>>(duration).count());
+  };
+  BOOST_TEST_MESSAGE("receive " << nPackets << " bare Data: " << (t2 - t1) << ", " <<
+                     packetsPerSecond(t2 - t1) << " packets/s");
+  BOOST_TEST_MESSAGE("receive " << nPackets << " Data in LpPacket: " << (t4 - t3) << ", " <<
+                     packetsPerSecond(t4 - t3) << " packets/s");
+  BOOST_TEST_MESSAGE("receive " << nPackets << " bare Interests: " << (t6 - t5) << ", " <<
+                     packetsPerSecond(t6 - t5) << " packets/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // FaceBenchmark
+
+} // namespace tests
+} // namespace ndn
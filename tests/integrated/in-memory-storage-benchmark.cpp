@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx InMemoryStorage Benchmark
+
+#include "util/in-memory-storage-persistent.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <thread>
+#include <tuple>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+static const size_t GROUP_SIZE = 100;
+
+static Name
+makeName(size_t i)
+{
+  return Name("/bench/ims").appendNumber(i / GROUP_SIZE).appendSequenceNumber(i % GROUP_SIZE);
+}
+
+// every group of GROUP_SIZE packets under the same prefix has only its last packet fresh
+static bool
+isFresh(size_t i)
+{
+  return i % GROUP_SIZE == GROUP_SIZE - 1;
+}
+
+BOOST_AUTO_TEST_CASE(Find)
+{
+  const size_t nEntries = 1000000;
+  const size_t nLookups = 100000;
+
+  boost::asio::io_service io;
+  InMemoryStoragePersistent ims(io);
+  std::vector<shared_ptr<const Data>> fresh;
+  std::vector<shared_ptr<const Data>> stale;
+  for (size_t i = 0; i < nEntries; ++i) {
+    auto data = make_shared<Data>(makeName(i));
+    data->setFreshnessPeriod(time::seconds(10));
+    SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    (isFresh(i) ? fresh : stale).push_back(data);
+  }
+  for (const auto& data : fresh) {
+    ims.insert(*data);
+  }
+  for (const auto& data : stale) {
+    ims.insert(*data, time::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  io.poll();
+  BOOST_REQUIRE_EQUAL(ims.size(), nEntries);
+
+  std::vector<Interest> exact;
+  std::vector<Interest> exactFresh;
+  std::vector<Interest> prefixFresh;
+  size_t nExpectedFresh = 0;
+  for (size_t i = 0; i < nLookups; ++i) {
+    // spread the lookups over the whole storage
+    size_t entry = (i * 7919) % nEntries;
+    if (isFresh(entry)) {
+      ++nExpectedFresh;
+    }
+
+    exact.emplace_back(makeName(entry));
+
+    exactFresh.emplace_back(makeName(entry));
+    exactFresh.back().setMustBeFresh(true);
+
+    prefixFresh.emplace_back(makeName(entry).getPrefix(-1));
+    prefixFresh.back().setMustBeFresh(true);
+  }
+
+  // every group has GROUP_SIZE - 1 stale packets before its only fresh packet,
+  // so a MustBeFresh prefix lookup always finds a Data
+  for (const auto& lookup : {std::make_tuple("exact name", &exact, nLookups),
+                             std::make_tuple("exact name, MustBeFresh", &exactFresh, nExpectedFresh),
+                             std::make_tuple("prefix, MustBeFresh", &prefixFresh, nLookups)}) {
+    size_t nFound = 0;
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (const auto& interest : *std::get<1>(lookup)) {
+      if (ims.find(interest) != nullptr) {
+        ++nFound;
+      }
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nFound, std::get<2>(lookup));
+    BOOST_TEST_MESSAGE(std::get<0>(lookup) << ": " << nLookups << " lookups in " << nEntries <<
+                       " entries: " << (t2 - t1));
+  }
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
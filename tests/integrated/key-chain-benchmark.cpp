@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx KeyChain Benchmark
+
+#include "security/v2/key-chain.hpp"
+#include "security/signing-helpers.hpp"
+#include "security/verification-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+static std::vector<Data>
+makePackets(size_t nPackets, size_t contentSize)
+{
+  const std::vector<uint8_t> content(contentSize, 0xEE);
+  std::vector<Data> packets;
+  packets.reserve(nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    packets.emplace_back(Name("/bench/key-chain").appendSegment(i));
+    packets.back().setContent(content.data(), content.size());
+  }
+  return packets;
+}
+
+BOOST_AUTO_TEST_CASE(SignBatch)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Identity ecIdentity = keyChain.createIdentity("/bench/key-chain/ECDSA-P256", EcKeyParams(256));
+  Identity rsaIdentity = keyChain.createIdentity("/bench/key-chain/RSA-2048", RsaKeyParams(2048));
+
+  const size_t nPackets = 5000;
+  std::vector<size_t> threadCounts = {1, 2, 4, 8};
+  size_t nHardwareThreads = std::thread::hardware_concurrency();
+  if (nHardwareThreads > 8) {
+    threadCounts.push_back(nHardwareThreads);
+  }
+
+  for (const Identity& identity : {ecIdentity, rsaIdentity}) {
+    SigningInfo signingInfo = signingByIdentity(identity);
+    std::string keyType = identity.getName().get(-1).toUri();
+
+    for (size_t nThreads : threadCounts) {
+      std::vector<Data> packets = makePackets(nPackets, 4096);
+      time::steady_clock::TimePoint t1 = time::steady_clock::now();
+      keyChain.signBatch(packets, signingInfo, nThreads);
+      time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+      BOOST_CHECK_GT(packets.back().getSignature().getValue().value_size(), 0);
+      BOOST_TEST_MESSAGE(keyType << ", " << nThreads << " threads: sign " << nPackets << " Data: " <<
+                         (t2 - t1));
+    }
+
+    // for comparison, signing one packet at a time
+    std::vector<Data> packets = makePackets(nPackets, 4096);
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (Data& data : packets) {
+      keyChain.sign(data, signingInfo);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_TEST_MESSAGE(keyType << ", sign(Data&) in a loop: sign " << nPackets << " Data: " <<
+                       (t2 - t1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SignWithManifest)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Identity identity = keyChain.createIdentity("/bench/key-chain/manifest", EcKeyParams(256));
+  Key key = identity.getDefaultKey();
+  SigningInfo signingInfo = signingByKey(key);
+
+  const size_t nPackets = 5000;
+
+  // baseline: one ECDSA signature per packet
+  std::vector<Data> packets = makePackets(nPackets, 4096);
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  keyChain.signBatch(packets, signingInfo, 1);
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  size_t nVerified = 0;
+  for (const Data& data : packets) {
+    nVerified += verifySignature(data, key);
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nVerified, nPackets);
+  BOOST_TEST_MESSAGE("ECDSA-P256 per packet: sign " << nPackets << " Data: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("ECDSA-P256 per packet: verify " << nPackets << " Data: " << (t3 - t2));
+
+  // one ECDSA signature per manifest, which covers a window of segments
+  SigningInfo manifestSigningInfo = SigningInfo(signingInfo).setManifestSigning(true);
+  for (size_t windowSize : {16, 256, 5000}) {
+    packets = makePackets(nPackets, 4096);
+    std::vector<std::vector<Data>> windows;
+    for (size_t i = 0; i < packets.size(); i += windowSize) {
+      windows.emplace_back(std::make_move_iterator(packets.begin() + i),
+                           std::make_move_iterator(packets.begin() + std::min(i + windowSize, packets.size())));
+    }
+    for (size_t i = 0; i < windows.size(); ++i) {
+      windows[i].emplace_back(Name("/bench/key-chain/manifest").appendSegment(i));
+    }
+
+    t1 = time::steady_clock::now();
+    for (std::vector<Data>& window : windows) {
+      keyChain.signBatch(window, manifestSigningInfo);
+    }
+    t2 = time::steady_clock::now();
+
+    std::vector<Data> manifests;
+    for (std::vector<Data>& window : windows) {
+      manifests.push_back(std::move(window.back()));
+      window.pop_back();
+    }
+    nVerified = 0;
+    for (size_t i = 0; i < windows.size(); ++i) {
+      if (!verifySignature(manifests[i], key)) {
+        continue;
+      }
+      for (const Data& data : windows[i]) {
+        nVerified += verifyMerkleProof(data, manifests[i]);
+      }
+    }
+    t3 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nVerified, nPackets);
+    BOOST_TEST_MESSAGE("Merkle manifest per " << windowSize << " packets: sign " << nPackets <<
+                       " Data: " << (t2 - t1));
+    BOOST_TEST_MESSAGE("Merkle manifest per " << windowSize << " packets: verify " << nPackets <<
+                       " Data: " << (t3 - t2));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SignSmallData)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Identity identity = keyChain.createIdentity("/bench/key-chain/small", EcKeyParams(256));
+
+  const size_t nPackets = 5000;
+
+  for (const auto& signingInfo : {signingWithSha256(), signingByIdentity(identity.getName())}) {
+    std::vector<Data> packets = makePackets(nPackets, 100);
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (Data& data : packets) {
+      keyChain.sign(data, signingInfo);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK(packets.back().hasWire());
+    BOOST_TEST_MESSAGE(signingInfo << ", 100-octet content: sign " << nPackets << " Data: " <<
+                       (t2 - t1));
+  }
+}
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Name Benchmark
+
+#include "name.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+// names decoded from packets, as seen by name tables
+static const Name NAME(Name("/ndn/edu/ucla/cs/irl/video/seg/%00%01").wireEncode());
+static const Name OTHER(Name("/ndn/edu/ucla/cs/irl/video/seg/%00%02").wireEncode());
+static const Name PREFIX(Name("/ndn/edu/ucla/cs/irl").wireEncode());
+
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  const size_t nIterations = 1000000;
+  std::hash<Name> hash;
+  size_t h = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    h ^= hash(NAME);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    h ^= hash(NAME.getPrefix(-2));
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(hash(NAME), hash(Name(NAME.toUri())));
+  BOOST_TEST_MESSAGE("hash: " << nIterations << " iterations: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("hash of getPrefix: " << nIterations << " iterations: " << (t3 - t2));
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  const size_t nIterations = 1000000;
+  size_t nLess = 0;
+  size_t nEqual = 0;
+  size_t nPrefixes = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    nLess += NAME.compare(OTHER) < 0 ? 1 : 0;
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    nEqual += NAME == OTHER ? 1 : 0;
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    nPrefixes += PREFIX.isPrefixOf(NAME) ? 1 : 0;
+  }
+  time::steady_clock::TimePoint t4 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nLess, nIterations);
+  BOOST_CHECK_EQUAL(nEqual, 0);
+  BOOST_CHECK_EQUAL(nPrefixes, nIterations);
+  BOOST_TEST_MESSAGE("compare: " << nIterations << " iterations: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("equals: " << nIterations << " iterations: " << (t3 - t2));
+  BOOST_TEST_MESSAGE("isPrefixOf: " << nIterations << " iterations: " << (t4 - t3));
+}
+
+BOOST_AUTO_TEST_CASE(GetPrefix)
+{
+  const size_t nIterations = 1000000;
+  size_t nComponents = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    nComponents += NAME.getPrefix(-2).size();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nComponents, 6 * nIterations);
+  BOOST_TEST_MESSAGE("getPrefix: " << nIterations << " iterations: " << (t2 - t1));
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx PibSqlite3 Benchmark
+
+#include "security/pib/pib-sqlite3.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace security {
+namespace pib {
+namespace tests {
+
+static std::vector<v2::Certificate>
+makeCertificates(size_t nCerts)
+{
+  std::vector<v2::Certificate> certs;
+  auto now = time::system_clock::now();
+  const uint8_t keyBits[] = {0x01, 0x02, 0x03, 0x04};
+  for (size_t i = 0; i < nCerts; ++i) {
+    Name keyName = Name("/bench/pib-sqlite3").appendNumber(i).append("KEY").appendNumber(i);
+    Data data(Name(keyName).append("self").appendVersion(1));
+    data.setContentType(tlv::ContentType_Key);
+    data.setFreshnessPeriod(time::hours(1));
+    data.setContent(keyBits, sizeof(keyBits));
+
+    SignatureInfo info(tlv::SignatureSha256WithEcdsa, KeyLocator(keyName));
+    info.setValidityPeriod(ValidityPeriod(now - time::days(1), now + time::days(1)));
+    Signature signature(info);
+    signature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+    data.setSignature(signature);
+    data.wireEncode();
+
+    certs.emplace_back(std::move(data));
+  }
+  return certs;
+}
+
+BOOST_AUTO_TEST_CASE(Insert)
+{
+  const size_t nCerts = 1000;
+  std::vector<v2::Certificate> certs = makeCertificates(nCerts);
+
+  for (bool useWal : {false, true}) {
+#ifdef NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+    if (useWal) {
+      BOOST_TEST_MESSAGE("WAL is not available without SQLite file system locking");
+      continue;
+    }
+#endif // NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+    boost::filesystem::path pibPath = boost::filesystem::temp_directory_path() /
+                                      boost::filesystem::unique_path();
+    {
+      PibSqlite3 pib(pibPath.string());
+      if (useWal) {
+        BOOST_REQUIRE(pib.enableWriteAheadLog());
+      }
+
+      time::steady_clock::TimePoint t1 = time::steady_clock::now();
+      for (size_t i = 0; i < nCerts / 2; ++i) {
+        pib.addCertificate(certs[i]);
+      }
+      time::steady_clock::TimePoint t2 = time::steady_clock::now();
+      pib.runInTransaction([&] {
+        for (size_t i = nCerts / 2; i < nCerts; ++i) {
+          pib.addCertificate(certs[i]);
+        }
+      });
+      time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+      BOOST_CHECK_EQUAL(pib.getIdentities().size(), nCerts);
+      BOOST_TEST_MESSAGE((useWal ? "WAL " : "") << "addCertificate: " << nCerts / 2 <<
+                         " certificates: " << (t2 - t1));
+      BOOST_TEST_MESSAGE((useWal ? "WAL " : "") << "addCertificate in one transaction: " <<
+                         nCerts / 2 << " certificates: " << (t3 - t2));
+    }
+    boost::filesystem::remove_all(pibPath);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Lookup)
+{
+  const size_t nCerts = 1000;
+  const size_t nLookups = 100000;
+  std::vector<v2::Certificate> certs = makeCertificates(nCerts);
+
+  for (bool useWal : {false, true}) {
+#ifdef NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+    if (useWal) {
+      BOOST_TEST_MESSAGE("WAL is not available without SQLite file system locking");
+      continue;
+    }
+#endif // NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+    boost::filesystem::path pibPath = boost::filesystem::temp_directory_path() /
+                                      boost::filesystem::unique_path();
+    {
+      PibSqlite3 pib(pibPath.string());
+      if (useWal) {
+        BOOST_REQUIRE(pib.enableWriteAheadLog());
+      }
+      pib.runInTransaction([&] {
+        for (const auto& cert : certs) {
+          pib.addCertificate(cert);
+        }
+      });
+
+      time::steady_clock::TimePoint t1 = time::steady_clock::now();
+      for (size_t i = 0; i < nLookups; ++i) {
+        pib.getDefaultIdentity();
+      }
+      time::steady_clock::TimePoint t2 = time::steady_clock::now();
+      for (size_t i = 0; i < nLookups; ++i) {
+        pib.getDefaultKeyOfIdentity(certs[i % nCerts].getIdentity());
+      }
+      time::steady_clock::TimePoint t3 = time::steady_clock::now();
+      for (size_t i = 0; i < nLookups; ++i) {
+        pib.getDefaultCertificateOfKey(certs[i % nCerts].getKeyName());
+      }
+      time::steady_clock::TimePoint t4 = time::steady_clock::now();
+
+      BOOST_TEST_MESSAGE((useWal ? "WAL " : "") << "getDefaultIdentity: " << nLookups <<
+                         " lookups: " << (t2 - t1));
+      BOOST_TEST_MESSAGE((useWal ? "WAL " : "") << "getDefaultKeyOfIdentity: " << nLookups <<
+                         " lookups: " << (t3 - t2));
+      BOOST_TEST_MESSAGE((useWal ? "WAL " : "") << "getDefaultCertificateOfKey: " << nLookups <<
+                         " lookups: " << (t4 - t3));
+    }
+    boost::filesystem::remove_all(pibPath);
+  }
+}
+
+} // namespace tests
+} // namespace pib
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Regex Benchmark
+
+#include "util/regex.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(Match)
+{
+  const size_t nMatches = 100000;
+
+  struct Case
+  {
+    std::string expr;
+    Name name;
+    std::string expand; ///< if not empty, each successful match is followed by expand()
+  };
+  const std::vector<Case> cases{
+    // TopMatcher in tests/unit-tests/util/regex.t.cpp
+    {"^<a><b><c>", "/a/b/c/d", ""},
+    {"<b><c><d>$", "/a/b/c/d", ""},
+    {"^<a><b><c><d>$", "/a/b/c/d", ""},
+    {"^<a><b><c><d>$", "/a/b/c/d/e", ""},
+    {"<a><b><c><d>", "/a/b/c/d", ""},
+    {"<b><c>", "/a/b/c/d", ""},
+    // TopMatcherAdvanced in tests/unit-tests/util/regex.t.cpp, with back references
+    {"^(<.*>*)<.*>", "/n/a/b/c", "\\1"},
+    {"^(<.*>*)<.*><c>(<.*>)<.*>", "/n/a/b/c/d/e/", "\\1\\2"},
+    {"(<.*>*)<.*>$", "/n/a/b/c/", "\\1"},
+    {"<.*>(<.*>*)<.*>$", "/n/a/b/c/", "\\1"},
+    {"<a>(<>*)<>$", "/n/a/b/c/", "\\1"},
+    {"^<ndn><(.*)\\.(.*)><DNS>(<>*)<>", "/ndn/ucla.edu/DNS/yingdi/mac/ksk-1/", "<ndn>\\2\\1\\3"},
+    // certificate names, as matched by validator rules
+    {"^<ndn><edu><ucla>", "/ndn/edu/ucla/yingdi/KEY/ksk-123/ID-CERT/%FD%01", ""},
+    {"^<ndn>(<>*)<KEY>(<>)<ID-CERT><>$", "/ndn/edu/ucla/yingdi/KEY/ksk-123/ID-CERT/%FD%01",
+     "\\1\\2"},
+    {"^([^<KEY>]*)<KEY>(<>*)<ksk-.*><ID-CERT>", "/ndn/edu/ucla/yingdi/KEY/ksk-123/ID-CERT/%FD%01",
+     "\\1"},
+  };
+
+  for (const auto& c : cases) {
+    Regex automaton(c.expr);
+    Regex backtracking(c.expr);
+
+    bool isMatchedByAutomaton = false;
+    Name expandedByAutomaton;
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (size_t i = 0; i < nMatches; ++i) {
+      isMatchedByAutomaton = automaton.match(c.name);
+      if (isMatchedByAutomaton && !c.expand.empty()) {
+        expandedByAutomaton = automaton.expand(c.expand);
+      }
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+    bool isMatchedByBacktracking = false;
+    Name expandedByBacktracking;
+    for (size_t i = 0; i < nMatches; ++i) {
+      isMatchedByBacktracking = backtracking.matchByBacktracking(c.name);
+      if (isMatchedByBacktracking && !c.expand.empty()) {
+        expandedByBacktracking = backtracking.expand(c.expand);
+      }
+    }
+    time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+    BOOST_TEST_CONTEXT(c.expr << " " << c.name) {
+      BOOST_CHECK_EQUAL(isMatchedByAutomaton, isMatchedByBacktracking);
+      BOOST_CHECK_EQUAL_COLLECTIONS(automaton.getMatchResult().begin(),
+                                    automaton.getMatchResult().end(),
+                                    backtracking.getMatchResult().begin(),
+                                    backtracking.getMatchResult().end());
+      BOOST_CHECK_EQUAL(expandedByAutomaton, expandedByBacktracking);
+    }
+    BOOST_TEST_MESSAGE(c.expr << " " << c.name << (c.expand.empty() ? "" : " expand " + c.expand) <<
+                       (isMatchedByAutomaton ? "" : " (no match)") << ": automaton " <<
+                       (t2 - t1) / nMatches << ", backtracking " << (t3 - t2) / nMatches <<
+                       " per match");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NestedRepetition)
+{
+  const size_t nMatches = 100000;
+  Name name;
+  for (size_t i = 0; i < 20; ++i) {
+    name.append("a");
+  }
+  Regex regex("^(<a>*)*<b>");
+
+  bool isMatched = true;
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nMatches; ++i) {
+    isMatched = regex.match(name);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  BOOST_CHECK(!isMatched);
+  BOOST_TEST_MESSAGE("automaton ^(<a>*)*<b>: " << nMatches << " matches: " << (t2 - t1));
+}
+
+} // namespace tests
+} // namespace ndn
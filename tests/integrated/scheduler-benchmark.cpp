@@ -32,54 +32,90 @@ namespace util {
 namespace scheduler {
 namespace tests {
 
+static const EventQueueType QUEUE_TYPES[] = {EventQueueType::ORDERED_SET,
+                                             EventQueueType::BINARY_HEAP};
+
 BOOST_AUTO_TEST_CASE(ScheduleCancel)
 {
-  boost::asio::io_service io;
-  Scheduler sched(io);
+  for (EventQueueType queueType : QUEUE_TYPES) {
+    boost::asio::io_service io;
+    Scheduler sched(io, queueType);
 
-  const int nEvents = 1000000;
-  std::vector<EventId> eventIds(nEvents);
+    const int nEvents = 1000000;
+    std::vector<EventId> eventIds(nEvents);
 
-  time::steady_clock::TimePoint t1 = time::steady_clock::now();
-  for (int i = 0; i < nEvents; ++i) {
-    eventIds[i] = sched.scheduleEvent(time::seconds(1), []{});
-  }
-  time::steady_clock::TimePoint t2 = time::steady_clock::now();
-  for (int i = 0; i < nEvents; ++i) {
-    sched.cancelEvent(eventIds[i]);
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (int i = 0; i < nEvents; ++i) {
+      eventIds[i] = sched.scheduleEvent(time::seconds(1), []{});
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+    for (int i = 0; i < nEvents; ++i) {
+      sched.cancelEvent(eventIds[i]);
+    }
+    time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+    BOOST_TEST_MESSAGE(queueType << ": schedule " << nEvents << " events: " << (t2 - t1));
+    BOOST_TEST_MESSAGE(queueType << ": cancel " << nEvents << " events: " << (t3 - t2));
   }
-  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleCancelRandomDelay)
+{
+  // resembles Interest timeouts: most events are cancelled before they expire, and their
+  // expiration times are not in the order of scheduling
+  for (EventQueueType queueType : QUEUE_TYPES) {
+    boost::asio::io_service io;
+    Scheduler sched(io, queueType);
+
+    const int nEvents = 1000000;
+    std::vector<EventId> eventIds(nEvents);
+    std::vector<time::milliseconds> delays(nEvents);
+    for (int i = 0; i < nEvents; ++i) {
+      delays[i] = time::milliseconds(1000 + (i * 7919) % 4000);
+    }
+
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (int i = 0; i < nEvents; ++i) {
+      eventIds[i] = sched.scheduleEvent(delays[i], []{});
+      if (i >= 1000) {
+        sched.cancelEvent(eventIds[i - 1000]);
+      }
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
 
-  BOOST_TEST_MESSAGE("schedule " << nEvents << " events: " << (t2 - t1));
-  BOOST_TEST_MESSAGE("cancel " << nEvents << " events: " << (t3 - t2));
+    BOOST_TEST_MESSAGE(queueType << ": schedule and cancel " << nEvents <<
+                       " events with random delay: " << (t2 - t1));
+  }
 }
 
 BOOST_AUTO_TEST_CASE(Execute)
 {
-  boost::asio::io_service io;
-  Scheduler sched(io);
-
-  const int nEvents = 1000000;
-  int nExpired = 0;
-
-  // Events should expire at t1, but execution finishes at t2. The difference is the overhead.
-  time::steady_clock::TimePoint t1 = time::steady_clock::now() + time::seconds(5);
-  time::steady_clock::TimePoint t2;
-  // +1ms ensures this extra event is executed last. In case the overhead is less than 1ms,
-  // it will be reported as 1ms.
-  sched.scheduleEvent(t1 - time::steady_clock::now() + time::milliseconds(1), [&] {
-    t2 = time::steady_clock::now();
-    BOOST_REQUIRE_EQUAL(nExpired, nEvents);
-  });
+  for (EventQueueType queueType : QUEUE_TYPES) {
+    boost::asio::io_service io;
+    Scheduler sched(io, queueType);
 
-  for (int i = 0; i < nEvents; ++i) {
-    sched.scheduleEvent(t1 - time::steady_clock::now(), [&] { ++nExpired; });
-  }
+    const int nEvents = 1000000;
+    int nExpired = 0;
+
+    // Events should expire at t1, but execution finishes at t2. The difference is the overhead.
+    time::steady_clock::TimePoint t1 = time::steady_clock::now() + time::seconds(5);
+    time::steady_clock::TimePoint t2;
+    // +1ms ensures this extra event is executed last. In case the overhead is less than 1ms,
+    // it will be reported as 1ms.
+    sched.scheduleEvent(t1 - time::steady_clock::now() + time::milliseconds(1), [&] {
+      t2 = time::steady_clock::now();
+      BOOST_REQUIRE_EQUAL(nExpired, nEvents);
+    });
 
-  io.run();
+    for (int i = 0; i < nEvents; ++i) {
+      sched.scheduleEvent(t1 - time::steady_clock::now(), [&] { ++nExpired; });
+    }
 
-  BOOST_REQUIRE_EQUAL(nExpired, nEvents);
-  BOOST_TEST_MESSAGE("execute " << nEvents << " events: " << (t2 - t1));
+    io.run();
+
+    BOOST_REQUIRE_EQUAL(nExpired, nEvents);
+    BOOST_TEST_MESSAGE(queueType << ": execute " << nEvents << " events: " << (t2 - t1));
+  }
 }
 
 } // namespace tests
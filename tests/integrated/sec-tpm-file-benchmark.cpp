@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx SecTpmFile Benchmark
+
+#include "security/v1/sec-tpm-file.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace security {
+namespace v1 {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(Sign)
+{
+  boost::filesystem::path tpmPath = boost::filesystem::temp_directory_path() /
+                                    boost::filesystem::unique_path();
+  SecTpmFile tpm(tpmPath.string());
+
+  const Name rsaKeyName("/bench/sec-tpm-file/RSA-2048");
+  tpm.generateKeyPairInTpm(rsaKeyName, RsaKeyParams(2048));
+  const Name ecKeyName("/bench/sec-tpm-file/ECDSA-P256");
+  tpm.generateKeyPairInTpm(ecKeyName, EcKeyParams(256));
+
+  const size_t nSignatures = 1000;
+  const std::vector<uint8_t> content(1024, 0xCC);
+
+  for (const Name& keyName : {rsaKeyName, ecKeyName}) {
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (size_t i = 0; i < nSignatures; ++i) {
+      tpm.signInTpm(content.data(), content.size(), keyName, DigestAlgorithm::SHA256);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_TEST_MESSAGE(keyName.get(-1).toUri() << ": " << nSignatures << " signatures: " << (t2 - t1));
+  }
+
+  boost::filesystem::remove_all(tpmPath);
+}
+
+} // namespace tests
+} // namespace v1
+} // namespace security
+} // namespace ndn
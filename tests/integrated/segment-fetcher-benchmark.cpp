@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx SegmentFetcher Benchmark
+
+#include "util/segment-fetcher.hpp"
+#include "util/dummy-client-face.hpp"
+#include "util/scheduler.hpp"
+#include "security/validator-null.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "identity-management-fixture.hpp"
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+static const uint64_t N_SEGMENTS = 500;
+static const size_t SEGMENT_SIZE = 4096;
+static const time::milliseconds DELAY(10);
+
+/** \brief serves a segmented object through \p face, answering each Interest after DELAY
+ */
+static void
+serveObject(DummyClientFace& face, Scheduler& scheduler)
+{
+  const Name versionedName = Name("/bench/object").appendVersion(1);
+  const std::vector<uint8_t> payload(SEGMENT_SIZE, 0xBB);
+  auto segments = make_shared<std::vector<shared_ptr<Data>>>();
+  for (uint64_t i = 0; i < N_SEGMENTS; ++i) {
+    auto data = make_shared<Data>(Name(versionedName).appendSegment(i));
+    data->setContent(payload.data(), payload.size());
+    data->setFinalBlockId(name::Component::fromSegment(N_SEGMENTS - 1));
+    SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    segments->push_back(data);
+  }
+
+  face.onSendInterest.connect([&face, &scheduler, segments] (const Interest& interest) {
+    uint64_t segmentNo = 0;
+    if (interest.getName().get(-1).isSegment()) {
+      segmentNo = interest.getName().get(-1).toSegment();
+    }
+    if (segmentNo < segments->size()) {
+      shared_ptr<Data> data = (*segments)[segmentNo];
+      scheduler.scheduleEvent(DELAY, [&face, data] { face.receive(*data); });
+    }
+  });
+}
+
+BOOST_FIXTURE_TEST_SUITE(SegmentFetcherBenchmark, IdentityManagementV1Fixture)
+
+BOOST_AUTO_TEST_CASE(StopAndWait)
+{
+  boost::asio::io_service io;
+  DummyClientFace face(io, m_keyChain, {false, false});
+  Scheduler scheduler(io);
+  serveObject(face, scheduler);
+
+  size_t nBytes = 0;
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  SegmentFetcher::fetch(face, Interest("/bench/object"), make_shared<ValidatorNull>(),
+                        [&] (const ConstBufferPtr& data) { nBytes = data->size(); },
+                        [] (uint32_t, const std::string& msg) { BOOST_FAIL(msg); });
+  io.run();
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nBytes, N_SEGMENTS * SEGMENT_SIZE);
+  BOOST_TEST_MESSAGE("stop-and-wait: fetch " << N_SEGMENTS << " segments with " << DELAY <<
+                     " delay: " << (t2 - t1));
+}
+
+BOOST_AUTO_TEST_CASE(Windowed)
+{
+  SegmentFetcher::Options fixed;
+  fixed.useConstantWindow = true;
+  fixed.initialWindow = 32;
+
+  SegmentFetcher::Options aimd;
+  aimd.initialWindow = 4;
+  aimd.aiStep = 4;
+
+  for (const auto& mode : {std::make_pair("fixed window 32", fixed),
+                           std::make_pair("AIMD", aimd)}) {
+    boost::asio::io_service io;
+    DummyClientFace face(io, m_keyChain, {false, false});
+    Scheduler scheduler(io);
+    serveObject(face, scheduler);
+
+    size_t nBytes = 0;
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    auto fetcher = SegmentFetcher::start(face, Interest("/bench/object"),
+                                         make_shared<ValidatorNull>(), mode.second);
+    fetcher->onComplete.connect([&] (const ConstBufferPtr& data) { nBytes = data->size(); });
+    fetcher->onError.connect([] (uint32_t, const std::string& msg) { BOOST_FAIL(msg); });
+    io.run();
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nBytes, N_SEGMENTS * SEGMENT_SIZE);
+    BOOST_TEST_MESSAGE(mode.first << ": fetch " << N_SEGMENTS << " segments with " << DELAY <<
+                       " delay: " << (t2 - t1));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // SegmentFetcherBenchmark
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
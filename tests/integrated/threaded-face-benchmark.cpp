@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx ThreadedFace Benchmark
+
+#include "util/threaded-face.hpp"
+#include "util/dummy-client-face.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+
+#include "identity-management-fixture.hpp"
+#include "boost-test.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+static shared_ptr<Data>
+makeData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  data->setContent(std::vector<uint8_t>(1024, 0xCC).data(), 1024);
+  SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+  data->setSignature(fakeSignature);
+  return data;
+}
+
+BOOST_FIXTURE_TEST_SUITE(ThreadedFaceBenchmark, IdentityManagementV1Fixture)
+
+BOOST_AUTO_TEST_CASE(MultiProducerPut)
+{
+  const size_t nPackets = 200000;
+
+  for (size_t nThreads : {1, 2, 4, 8}) {
+    std::atomic<size_t> nSent(0);
+    time::steady_clock::TimePoint t1, t2;
+    {
+      ThreadedFace face([&] (boost::asio::io_service& io) {
+        auto dummyFace = make_unique<DummyClientFace>(io, m_keyChain,
+                                                      DummyClientFace::Options{false, false});
+        dummyFace->onSendData.connect([&] (const Data&) { ++nSent; });
+        return unique_ptr<Face>(std::move(dummyFace));
+      });
+
+      // each producer creates, encodes, and puts its share of the Data packets
+      t1 = time::steady_clock::now();
+      std::vector<std::thread> producers;
+      for (size_t i = 0; i < nThreads; ++i) {
+        producers.emplace_back([&face, i, nThreads, nPackets] {
+          for (size_t j = i; j < nPackets; j += nThreads) {
+            face.put(*makeData(Name("/bench/put").appendSequenceNumber(j)));
+          }
+        });
+      }
+      for (auto& producer : producers) {
+        producer.join();
+      }
+    } // destructor returns after all queued Data are sent
+    t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nSent, nPackets);
+    BOOST_TEST_MESSAGE(nThreads << " producers: put " << nPackets << " Data: " << (t2 - t1));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ThreadedFaceBenchmark
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
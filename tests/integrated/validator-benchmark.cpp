@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Validator Benchmark
+
+#include "security/v2/validator.hpp"
+#include "security/v2/validation-policy-simple-hierarchy.hpp"
+#include "security/v2/certificate-fetcher-offline.hpp"
+#include "security/v2/key-chain.hpp"
+#include "security/signing-helpers.hpp"
+#include "security/verification-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+static std::vector<Data>
+makeSignedPackets(KeyChain& keyChain, const Identity& identity, size_t nPackets)
+{
+  const std::vector<uint8_t> content(1024, 0xAA);
+  std::vector<Data> packets;
+  for (size_t i = 0; i < nPackets; ++i) {
+    packets.emplace_back(Name("/bench/validator/data").appendSegment(i));
+    packets.back().setContent(content.data(), content.size());
+  }
+  keyChain.signBatch(packets, signingByIdentity(identity));
+  return packets;
+}
+
+BOOST_AUTO_TEST_CASE(VerificationExecutor)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Identity identity = keyChain.createIdentity("/bench/validator", EcKeyParams(256));
+  const size_t nPackets = 5000;
+  std::vector<Data> packets = makeSignedPackets(keyChain, identity, nPackets);
+
+  boost::asio::io_service io;
+  Validator validator(make_unique<ValidationPolicySimpleHierarchy>(),
+                      make_unique<CertificateFetcherOffline>());
+  validator.loadAnchor("", Certificate(identity.getDefaultKey().getDefaultCertificate()));
+
+  // zero threads stands for synchronous verification on the calling thread
+  std::vector<size_t> threadCounts = {0, 1, 2, 4};
+  size_t nHardwareThreads = std::thread::hardware_concurrency();
+  if (nHardwareThreads > 4) {
+    threadCounts.push_back(nHardwareThreads);
+  }
+
+  for (size_t nThreads : threadCounts) {
+    if (nThreads > 0) {
+      validator.setVerificationExecutor(make_unique<v2::VerificationExecutor>(io, nThreads));
+    }
+
+    size_t nValidated = 0;
+    size_t nFailed = 0;
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (const Data& data : packets) {
+      validator.validate(data,
+                         [&] (const Data&) { ++nValidated; },
+                         [&] (const Data&, const ValidationError&) { ++nFailed; });
+    }
+    io.run();
+    io.reset();
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nValidated, nPackets);
+    BOOST_CHECK_EQUAL(nFailed, 0);
+    BOOST_TEST_MESSAGE(nThreads << " verification threads: validate " << nPackets << " Data: " <<
+                       (t2 - t1));
+  }
+  validator.setVerificationExecutor(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ParsedPublicKey)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Identity identity = keyChain.createIdentity("/bench/validator", EcKeyParams(256));
+  const size_t nPackets = 5000;
+  std::vector<Data> packets = makeSignedPackets(keyChain, identity, nPackets);
+  Certificate cert = identity.getDefaultKey().getDefaultCertificate();
+  const Block& keyBits = cert.getContent();
+
+  size_t nVerifiedPerPacket = 0;
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (const Data& data : packets) {
+    nVerifiedPerPacket += verifySignature(data, keyBits.value(), keyBits.value_size());
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  size_t nVerifiedPerCert = 0;
+  for (const Data& data : packets) {
+    nVerifiedPerCert += verifySignature(data, cert);
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nVerifiedPerPacket, nPackets);
+  BOOST_CHECK_EQUAL(nVerifiedPerCert, nPackets);
+  BOOST_TEST_MESSAGE("PKCS#8 key decoded per packet: verify " << nPackets << " Data: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("key decoded once per certificate: verify " << nPackets << " Data: " << (t3 - t2));
+}
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
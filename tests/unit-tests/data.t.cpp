@@ -22,6 +22,7 @@
 #include "data.hpp"
 #include "security/v1/cryptopp.hpp"
 #include "encoding/buffer-stream.hpp"
+#include "util/crypto.hpp"
 
 #include "boost-test.hpp"
 #include "identity-management-fixture.hpp"
@@ -315,6 +316,35 @@ BOOST_FIXTURE_TEST_CASE(Encode, TestDataFixture)
                     "Signature: (type: 1, value_length: 128)\n");
 }
 
+BOOST_AUTO_TEST_CASE(EncodeWithSignatureValue)
+{
+  Data d(Name("/local/ndn/prefix"));
+  d.setFreshnessPeriod(time::seconds(10));
+  d.setContent(Content1, sizeof(Content1));
+  d.setSignature(Signature(SignatureInfo(tlv::DigestSha256)));
+
+  const size_t maxSignatureValueSize = 34;
+  EncodingBuffer encoder(d.estimateSigningBufferSize(maxSignatureValueSize), maxSignatureValueSize);
+  shared_ptr<Buffer> buffer = encoder.getBuffer();
+  d.wireEncode(encoder, true);
+
+  Block signatureValue(tlv::SignatureValue, crypto::computeSha256Digest(encoder.buf(), encoder.size()));
+  signatureValue.encode();
+  BOOST_REQUIRE_EQUAL(signatureValue.size(), maxSignatureValueSize);
+  const Block& wire = d.wireEncode(encoder, signatureValue);
+  BOOST_CHECK(encoder.getBuffer() == buffer); // not reallocated
+
+  BOOST_CHECK(d.getContent().getBuffer() == wire.getBuffer());
+  BOOST_CHECK(d.getSignature().getValue() == signatureValue);
+
+  Data decoded(wire);
+  BOOST_CHECK_EQUAL(decoded, d);
+  BOOST_CHECK(decoded.wireEncode() == wire);
+
+  d.setContent(Content1, 1);
+  BOOST_CHECK_NE(decoded, d);
+}
+
 BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
 {
   // Encoding pipeline
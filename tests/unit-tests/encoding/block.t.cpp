@@ -429,6 +429,49 @@ BOOST_AUTO_TEST_CASE(Equality)
   BOOST_CHECK_EQUAL(e != f, true);
 }
 
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  static const uint8_t WIRE[] = {
+    0x05, 0x0e,
+          0x07, 0x06,
+                0x08, 0x01, 0x41,
+                0x08, 0x01, 0x42,
+          0x0a, 0x00,
+          0x0c, 0x02, 0x0f, 0xa0,
+  };
+
+  Block block(WIRE, sizeof(WIRE));
+  block.parse();
+  BOOST_REQUIRE_EQUAL(block.elements_size(), 3);
+  BOOST_CHECK_EQUAL(block.elements().capacity(), 3);
+  BOOST_CHECK_EQUAL(block.elements()[0].type(), tlv::Name);
+  BOOST_CHECK_EQUAL(block.elements()[0].value_size(), 6);
+  BOOST_CHECK_EQUAL(block.elements()[1].type(), tlv::Nonce);
+  BOOST_CHECK_EQUAL(block.elements()[1].value_size(), 0);
+  BOOST_CHECK_EQUAL(block.elements()[2].type(), tlv::InterestLifetime);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(block.elements()[2]), 4000);
+
+  // elements share the buffer of the parent
+  BOOST_CHECK_EQUAL(block.elements()[0].getBuffer(), block.getBuffer());
+
+  // only the top level is parsed
+  BOOST_CHECK_EQUAL(block.elements()[0].elements_size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ParseMalformed)
+{
+  // last element exceeds the value of the outer block
+  static const uint8_t WIRE[] = {
+    0x05, 0x06,
+          0x08, 0x01, 0x41,
+          0x08, 0x03, 0x42,
+  };
+
+  Block block(WIRE, sizeof(WIRE));
+  BOOST_CHECK_THROW(block.parse(), tlv::Error);
+  BOOST_CHECK_EQUAL(block.elements_size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(InsertBeginning)
 {
   Block masterBlock(tlv::Name);
@@ -415,6 +415,9 @@ BOOST_AUTO_TEST_CASE(PrintSignatureTypeValue)
   value = SignatureSha256WithEcdsa;
   BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(value), "SignatureSha256WithEcdsa");
 
+  value = SignatureSha256WithMerkleProof;
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(value), "SignatureSha256WithMerkleProof");
+
   value = static_cast<SignatureTypeValue>(-1);
   BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(value), "Unknown Signature Type");
 }
@@ -94,6 +94,36 @@ BOOST_AUTO_TEST_CASE(ExpressInterestData)
   BOOST_CHECK_EQUAL(nTimeouts, 1);
 }
 
+BOOST_AUTO_TEST_CASE(ExpressInterestDataFields)
+{
+  // a bare Data bypasses lp::Packet, all fields must still be available to the callback
+  auto data = make_shared<Data>("/Hello/World/a");
+  data->setFreshnessPeriod(time::seconds(1));
+  const uint8_t content[] = {0x01, 0x02, 0x03};
+  data->setContent(content, sizeof(content));
+  signData(data);
+
+  size_t nData = 0;
+  face.expressInterest(Interest("/Hello/World", time::milliseconds(50)),
+                       [&] (const Interest&, const Data& d) {
+                         BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), time::seconds(1));
+                         BOOST_CHECK_EQUAL_COLLECTIONS(d.getContent().value_begin(),
+                                                       d.getContent().value_end(),
+                                                       content, content + sizeof(content));
+                         BOOST_CHECK_EQUAL(d.getSignature().getType(), tlv::SignatureSha256WithRsa);
+                         BOOST_CHECK_EQUAL(d.getFullName(), data->getFullName());
+                         ++nData;
+                       },
+                       bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                       bind([] { BOOST_FAIL("Unexpected timeout"); }));
+
+  advanceClocks(time::milliseconds(10));
+  face.receive(*data);
+  advanceClocks(time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(nData, 1);
+}
+
 BOOST_AUTO_TEST_CASE(ExpressMultipleInterestData)
 {
   size_t nData = 0;
@@ -123,6 +153,66 @@ BOOST_AUTO_TEST_CASE(ExpressMultipleInterestData)
   BOOST_CHECK_EQUAL(face.sentData.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ExpressInterestDataMatchOrder)
+{
+  shared_ptr<Data> data = makeData("/A/B/C");
+  std::vector<std::string> satisfied;
+  auto expressNamed = [&] (const Name& name) {
+    face.expressInterest(Interest(name, time::milliseconds(50)),
+                         [&satisfied, name] (const Interest&, const Data&) {
+                           satisfied.push_back(name.toUri());
+                         },
+                         bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                         nullptr);
+  };
+
+  expressNamed("/A/B/C");
+  expressNamed("/A");
+  expressNamed(data->getFullName());
+  expressNamed("/A/B/D");
+  expressNamed("/A/B/C/D");
+  expressNamed(Name("/A/B/C").appendImplicitSha256Digest(make_shared<Buffer>(32)));
+  expressNamed("/");
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 7);
+
+  face.receive(*data);
+  advanceClocks(time::milliseconds(10));
+
+  std::vector<std::string> expected{"/A/B/C", "/A", data->getFullName().toUri(), "/"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(satisfied.begin(), satisfied.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestDataCallbackExpress)
+{
+  // an Interest expressed from within a DataCallback is satisfied by the same Data,
+  // as the matching entries are extracted one at a time
+  std::vector<std::string> satisfied;
+  face.expressInterest(Interest("/A", time::milliseconds(50)),
+                       [&] (const Interest&, const Data&) {
+                         satisfied.push_back("first");
+                         face.expressInterest(Interest("/A/B", time::milliseconds(50)),
+                                              [&] (const Interest&, const Data&) {
+                                                satisfied.push_back("second");
+                                              },
+                                              bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                                              nullptr);
+                       },
+                       bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                       nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+
+  // deliver the Data from the I/O thread, so that expressInterest takes effect immediately
+  io.post([this] { face.receive(*makeData("/A/B/C")); });
+  advanceClocks(time::milliseconds(10));
+
+  std::vector<std::string> expected{"first", "second"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(satisfied.begin(), satisfied.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(ExpressInterestEmptyDataCallback)
 {
   face.expressInterest(Interest("/Hello/World"),
@@ -592,6 +682,35 @@ BOOST_AUTO_TEST_CASE(SimilarFilters)
   BOOST_CHECK_EQUAL(nInInterests3, 0);
 }
 
+BOOST_AUTO_TEST_CASE(FilterDispatchOrder)
+{
+  std::vector<std::string> dispatched;
+  auto setFilter = [&] (const InterestFilter& filter, const std::string& label) {
+    return face.setInterestFilter(filter,
+                                  [&dispatched, label] (const InterestFilter&, const Interest&) {
+                                    dispatched.push_back(label);
+                                  });
+  };
+
+  setFilter("/A/B/C", "abc");
+  setFilter(InterestFilter("/A", "<B><>*"), "a-regex");
+  setFilter("/", "root");
+  const InterestFilterId* unsetId = setFilter("/A/B", "ab-unset");
+  setFilter(InterestFilter("/A/B", "<D>"), "ab-regex-nomatch");
+  setFilter("/A/B/C/D", "abcd");
+  setFilter("/A", "a");
+  advanceClocks(time::milliseconds(10));
+
+  face.unsetInterestFilter(unsetId);
+  advanceClocks(time::milliseconds(10));
+
+  face.receive(Interest("/A/B/C"));
+  advanceClocks(time::milliseconds(10));
+
+  std::vector<std::string> expected{"abc", "a-regex", "root", "a"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(dispatched.begin(), dispatched.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_CASE(SetRegexFilterError)
 {
   face.setInterestFilter(InterestFilter("/Hello/World", "<><b><c>?"),
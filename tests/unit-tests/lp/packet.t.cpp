@@ -324,6 +324,22 @@ BOOST_AUTO_TEST_CASE(DecodeBareNetworkLayerPacket)
   BOOST_CHECK_NO_THROW(encoded = packet.wireEncode());
   BOOST_CHECK_EQUAL_COLLECTIONS(inputBlock, inputBlock + sizeof(inputBlock),
                                 encoded.begin(), encoded.end());
+
+  // Fragment refers to the buffer of the decoded packet
+  Buffer::const_iterator first, last;
+  std::tie(first, last) = packet.get<FragmentField>();
+  BOOST_CHECK(first == wire.begin());
+  BOOST_CHECK(last == wire.end());
+
+  packet.add<CongestionMarkField>(1);
+  BOOST_CHECK_NO_THROW(encoded = packet.wireEncode());
+  BOOST_CHECK_EQUAL(encoded.type(), tlv::LpPacket);
+  encoded.parse();
+  BOOST_REQUIRE_EQUAL(encoded.elements().size(), 2);
+  const Block& fragment = encoded.elements().back();
+  BOOST_CHECK_EQUAL(fragment.type(), tlv::Fragment);
+  BOOST_CHECK_EQUAL_COLLECTIONS(inputBlock, inputBlock + sizeof(inputBlock),
+                                fragment.value_begin(), fragment.value_end());
 }
 
 BOOST_AUTO_TEST_CASE(DecodeUnrecognizedTlvType)
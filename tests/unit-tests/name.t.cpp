@@ -24,7 +24,9 @@
 #include "boost-test.hpp"
 #include <boost/tuple/tuple.hpp>
 #include <boost/mpl/vector.hpp>
+#include <boost/functional/hash.hpp>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace ndn {
 namespace tests {
@@ -316,6 +318,44 @@ BOOST_AUTO_TEST_CASE(UnorderedMap)
   BOOST_CHECK_EQUAL(map[name3], 3);
 }
 
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  Name name("/hello/world");
+  Name decoded(name.wireEncode());
+  name.clear(); // drops the wire encoding
+  name.append("hello").append("world");
+  BOOST_REQUIRE(!name.hasWire());
+
+  std::hash<Name> hash;
+  size_t h = hash(decoded);
+  BOOST_CHECK_EQUAL(hash(name), h);
+  BOOST_CHECK(!name.hasWire()); // computed without encoding
+
+  // hash matches the hash of the TLV encoding
+  BOOST_CHECK_EQUAL(h, boost::hash_range(decoded.wireEncode().wire(),
+                                         decoded.wireEncode().wire() + decoded.wireEncode().size()));
+
+  // cached value is invalidated by modification
+  name.append("A");
+  BOOST_CHECK_NE(hash(name), h);
+  decoded.appendNumber(1);
+  BOOST_CHECK_NE(hash(decoded), h);
+  decoded.wireDecode(Name("/hello/world").wireEncode());
+  BOOST_CHECK_EQUAL(hash(decoded), h);
+  decoded.clear();
+  BOOST_CHECK_EQUAL(hash(decoded), hash(Name()));
+
+  // component without wire encoding
+  Name nested;
+  nested.append(makeNonNegativeIntegerBlock(tlv::NameComponent + 1, 1));
+  BOOST_CHECK_EQUAL(hash(nested), hash(Name(nested.wireEncode())));
+
+  // long component uses a three-octet TLV-LENGTH
+  Name longName;
+  longName.append(std::string(300, 'x').c_str());
+  BOOST_CHECK_EQUAL(hash(longName), hash(Name(longName.wireEncode())));
+}
+
 BOOST_AUTO_TEST_CASE(ImplicitSha256Digest)
 {
   Name n;
@@ -418,6 +458,78 @@ BOOST_AUTO_TEST_CASE(Compare)
   BOOST_CHECK_GT   (Name("/Z/A/C/Y").compare(1, 2, Name("/X/A"),   1), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CompareWire)
+{
+  // names decoded from wire are compared on their encoding
+  const std::vector<Name> names{"/", "/A", "/A/B", "/A/C", "/AA", "/B", "/B/A", "/Z/A/C/Y",
+                                Name("/A").appendNumber(300), Name("/A").appendNumber(1)};
+  for (const Name& a : names) {
+    for (const Name& b : names) {
+      Name aWire(a.wireEncode());
+      Name bWire(b.wireEncode());
+      BOOST_REQUIRE(aWire.hasWire() && bWire.hasWire());
+
+      int comp = a.compare(b);
+      BOOST_CHECK_EQUAL(aWire.compare(bWire) < 0, comp < 0);
+      BOOST_CHECK_EQUAL(aWire.compare(bWire) > 0, comp > 0);
+      BOOST_CHECK_EQUAL(aWire.compare(b) < 0, comp < 0);
+      BOOST_CHECK_EQUAL(aWire.equals(bWire), a.equals(b));
+      BOOST_CHECK_EQUAL(aWire.isPrefixOf(bWire), a.isPrefixOf(b));
+
+      size_t pos2 = std::min<size_t>(b.size(), 1);
+      for (size_t pos = 0; pos < a.size(); ++pos) {
+        for (size_t count = 1; pos + count <= a.size(); ++count) {
+          int subComp = a.compare(pos, count, b, pos2);
+          BOOST_CHECK_EQUAL(aWire.compare(pos, count, bWire, pos2) < 0, subComp < 0);
+          BOOST_CHECK_EQUAL(aWire.compare(pos, count, bWire, pos2) > 0, subComp > 0);
+        }
+      }
+    }
+  }
+
+  // components of a re-encoded Block are not contiguous in its wire encoding
+  Block block(tlv::Name);
+  block.push_back(name::Component("A"));
+  block.push_back(name::Component("B"));
+  block.encode();
+  Name reencoded(block);
+  BOOST_CHECK_EQUAL(reencoded.compare(Name(Name("/A/B").wireEncode())), 0);
+  BOOST_CHECK(reencoded.isPrefixOf(Name(Name("/A/B/C").wireEncode())));
+  BOOST_CHECK_EQUAL(reencoded.getPrefix(1), Name("/A"));
+}
+
+BOOST_AUTO_TEST_CASE(NonMinimalEncoding)
+{
+  // TLV-LENGTH of the Name and of the first NameComponent take more octets than necessary
+  const uint8_t WIRE[] = {
+    0x07, 0xfd, 0x00, 0x08,
+          0x08, 0xfd, 0x00, 0x01, 0x41,
+          0x08, 0x01, 0x42
+  };
+  Name nonMinimal(Block(WIRE, sizeof(WIRE)));
+  Name minimal(Name("/A/B").wireEncode());
+  BOOST_REQUIRE(nonMinimal.hasWire() && minimal.hasWire());
+
+  std::hash<Name> hash;
+  BOOST_CHECK_EQUAL(hash(nonMinimal), hash(minimal));
+  BOOST_CHECK_EQUAL(hash(nonMinimal), hash(Name("/A/B")));
+  BOOST_CHECK(nonMinimal.equals(minimal));
+  BOOST_CHECK(minimal.equals(nonMinimal));
+
+  BOOST_CHECK(nonMinimal.isPrefixOf(minimal));
+  BOOST_CHECK(minimal.isPrefixOf(nonMinimal));
+  BOOST_CHECK(nonMinimal.isPrefixOf(Name(Name("/A/B/C").wireEncode())));
+  BOOST_CHECK(Name(Name("/A").wireEncode()).isPrefixOf(nonMinimal));
+  BOOST_CHECK(!nonMinimal.isPrefixOf(Name(Name("/A/C").wireEncode())));
+
+  BOOST_CHECK_LT(nonMinimal.compare(Name(Name("/A/C").wireEncode())), 0);
+  BOOST_CHECK_LT(nonMinimal.compare(Name(Name("/A/B/C").wireEncode())), 0);
+  BOOST_CHECK_GT(nonMinimal.compare(Name(Name("/A").wireEncode())), 0);
+
+  std::unordered_set<Name> names{minimal};
+  BOOST_CHECK_EQUAL(names.count(nonMinimal), 1);
+}
+
 BOOST_AUTO_TEST_CASE(NameWithSpaces)
 {
   Name name("/ hello\t/\tworld \r\n");
@@ -454,6 +566,21 @@ BOOST_AUTO_TEST_CASE(SubName)
   BOOST_CHECK_EQUAL("/hello/", name.getSubName(0, 1));
 }
 
+BOOST_AUTO_TEST_CASE(SubNameWire)
+{
+  Name name(Name("/first/second/third/last").wireEncode());
+
+  PartialName subName = name.getSubName(1, 2);
+  BOOST_CHECK_EQUAL(subName, "/second/third");
+  BOOST_CHECK(subName.wireEncode() == Name("/second/third").wireEncode());
+  BOOST_CHECK_EQUAL(subName.getPrefix(-1), "/second");
+
+  BOOST_CHECK_EQUAL(name.getPrefix(-1), "/first/second/third");
+  BOOST_CHECK_EQUAL(name.getSubName(-1), "/last");
+  BOOST_CHECK_EQUAL(name.getSubName(10), "/");
+  BOOST_CHECK_EQUAL(name.getSubName(0, 0), "/");
+}
+
 BOOST_AUTO_TEST_CASE(SubNameNegativeIndex)
 {
   Name name("/first/second/third/last");
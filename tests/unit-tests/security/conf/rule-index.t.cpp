@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/conf/rule-index.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace conf {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(Conf)
+BOOST_AUTO_TEST_SUITE(TestRuleIndex)
+
+static shared_ptr<Rule<Data>>
+makeRule(const std::string& id, const std::vector<shared_ptr<Filter>>& filters)
+{
+  auto rule = make_shared<Rule<Data>>(id);
+  for (const auto& filter : filters) {
+    rule->addFilter(filter);
+  }
+  return rule;
+}
+
+BOOST_AUTO_TEST_CASE(MatchedPrefix)
+{
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<ndn><edu><>*")).getMatchedPrefix(), "/ndn/edu");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<ndn><edu>*")).getMatchedPrefix(), "/ndn");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<ndn>(<edu>)")).getMatchedPrefix(), "/ndn");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<ndn><ed.>")).getMatchedPrefix(), "/ndn");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("<ndn><edu>")).getMatchedPrefix(), "/");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^[^<KEY>]*<KEY>")).getMatchedPrefix(), "/");
+
+  BOOST_CHECK_EQUAL(RelationNameFilter("/ndn/edu", RelationNameFilter::RELATION_IS_STRICT_PREFIX_OF)
+                      .getMatchedPrefix(), "/ndn/edu");
+
+  auto rule = makeRule("rule", {make_shared<RelationNameFilter>("/ndn", RelationNameFilter::RELATION_IS_PREFIX_OF),
+                                make_shared<RegexNameFilter>(Regex("^<ndn><edu><ucla>"))});
+  BOOST_CHECK_EQUAL(rule->getMatchedPrefix(), "/ndn/edu/ucla");
+  BOOST_CHECK_EQUAL(makeRule("any", {})->getMatchedPrefix(), "/");
+}
+
+BOOST_AUTO_TEST_CASE(FindFirstMatch)
+{
+  auto ucla = makeRule("ucla", {make_shared<RegexNameFilter>(Regex("^<ndn><edu><ucla><>$"))});
+  auto edu = makeRule("edu", {make_shared<RelationNameFilter>("/ndn/edu",
+                                                              RelationNameFilter::RELATION_IS_PREFIX_OF)});
+  auto key = makeRule("key", {make_shared<RegexNameFilter>(Regex("^<>*<KEY><>$"))});
+  auto any = makeRule("any", {});
+
+  RuleIndex<Data> index;
+  BOOST_CHECK(index.empty());
+  BOOST_CHECK(index.findFirstMatch(Data("/ndn/edu/ucla/A")) == nullptr);
+
+  index.insert(ucla);
+  index.insert(edu);
+  index.insert(key);
+  BOOST_CHECK_EQUAL(index.size(), 3);
+
+  BOOST_CHECK_EQUAL(index.findFirstMatch(Data("/ndn/edu/ucla/A")), ucla);
+  BOOST_CHECK_EQUAL(index.findFirstMatch(Data("/ndn/edu/ucla/A/B")), edu);
+  BOOST_CHECK_EQUAL(index.findFirstMatch(Data("/ndn/edu/ucla/KEY/A")), edu);
+  BOOST_CHECK_EQUAL(index.findFirstMatch(Data("/ndn/com/KEY/A")), key);
+  BOOST_CHECK(index.findFirstMatch(Data("/ndn/com/A")) == nullptr);
+
+  // a rule without filters matches any packet not matched by an earlier rule
+  index.insert(any);
+  BOOST_CHECK_EQUAL(index.findFirstMatch(Data("/ndn/edu/ucla/A")), ucla);
+  BOOST_CHECK_EQUAL(index.findFirstMatch(Data("/ndn/com/A")), any);
+
+  index.clear();
+  BOOST_CHECK(index.empty());
+  BOOST_CHECK(index.findFirstMatch(Data("/ndn/com/A")) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRuleIndex
+BOOST_AUTO_TEST_SUITE_END() // Conf
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace conf
+} // namespace security
+} // namespace ndn
@@ -20,8 +20,12 @@
  */
 
 #include "security/pib/pib-sqlite3.hpp"
+#include "security/pib/pib.hpp"
 
 #include "boost-test.hpp"
+#include "pib-data-fixture.hpp"
+
+#include <boost/filesystem.hpp>
 
 namespace ndn {
 namespace security {
@@ -30,10 +34,69 @@ namespace tests {
 
 BOOST_AUTO_TEST_SUITE(Security)
 BOOST_AUTO_TEST_SUITE(Pib)
-BOOST_AUTO_TEST_SUITE(TestPibSqlite3)
+
+using pib::Pib;
+
+class PibSqlite3Fixture : public ndn::security::tests::PibDataFixture
+{
+public:
+  PibSqlite3Fixture()
+    : tmpPath(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "DbTest")
+    , pib(tmpPath.c_str())
+  {
+  }
+
+  ~PibSqlite3Fixture()
+  {
+    boost::filesystem::remove_all(tmpPath);
+  }
+
+public:
+  boost::filesystem::path tmpPath;
+  PibSqlite3 pib;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestPibSqlite3, PibSqlite3Fixture)
 
 // Functionality is tested as part of pib-impl.t.cpp
 
+BOOST_AUTO_TEST_CASE(RunInTransaction)
+{
+  pib.runInTransaction([this] {
+    pib.addCertificate(id1Key1Cert1);
+    pib.addCertificate(id1Key1Cert2);
+  });
+  BOOST_CHECK(pib.hasCertificate(id1Key1Cert1.getName()));
+  BOOST_CHECK(pib.hasCertificate(id1Key1Cert2.getName()));
+
+  BOOST_CHECK_THROW(pib.runInTransaction([this] {
+                      pib.addCertificate(id2Key1Cert1);
+                      pib.setDefaultCertificateOfKey(id1Key1Name, id2Key1Cert2.getName());
+                    }), Pib::Error);
+  BOOST_CHECK(!pib.hasIdentity(id2));
+  BOOST_CHECK(!pib.hasCertificate(id2Key1Cert1.getName()));
+  BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), id1);
+  BOOST_CHECK_EQUAL(pib.getDefaultCertificateOfKey(id1Key1Name), id1Key1Cert1);
+}
+
+BOOST_AUTO_TEST_CASE(WriteAheadLog)
+{
+  pib.addCertificate(id1Key1Cert1);
+#ifdef NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+  // the unix-dotfile VFS does not provide the shared memory that WAL needs
+  BOOST_CHECK(!pib.enableWriteAheadLog());
+#else
+  BOOST_CHECK(pib.enableWriteAheadLog());
+#endif // NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+
+  pib.addCertificate(id1Key1Cert2);
+  BOOST_CHECK_EQUAL(pib.getCertificatesOfKey(id1Key1Name).size(), 2);
+
+  PibSqlite3 pib2(tmpPath.c_str());
+  BOOST_CHECK_EQUAL(pib2.getCertificatesOfKey(id1Key1Name).size(), 2);
+  BOOST_CHECK_EQUAL(pib2.getDefaultCertificateOfKey(id1Key1Name), id1Key1Cert1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPibSqlite3
 BOOST_AUTO_TEST_SUITE_END() // Pib
 BOOST_AUTO_TEST_SUITE_END() // Security
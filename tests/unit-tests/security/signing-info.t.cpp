@@ -199,6 +199,14 @@ BOOST_AUTO_TEST_CASE(OperatorEquals)
   SignatureInfo sigInfo2(tlv::SignatureTypeValue::SignatureSha256WithRsa);
   info2.setSignatureInfo(sigInfo2);
   BOOST_CHECK_NE(info1, info2);
+
+  // Change manifest signing, check inequality
+  info1 = SigningInfo("id:/my-id");
+  info2 = SigningInfo("id:/my-id");
+  BOOST_CHECK_EQUAL(info1.isManifestSigning(), false);
+  info2.setManifestSigning(true);
+  BOOST_CHECK_EQUAL(info2.isManifestSigning(), true);
+  BOOST_CHECK_NE(info1, info2);
 }
 
 BOOST_AUTO_TEST_CASE(OperatorEqualsDifferentTypes)
@@ -407,6 +407,62 @@ BOOST_AUTO_TEST_CASE(ImportExportEcKey)
   BOOST_REQUIRE_EQUAL(tpm.doesKeyExistInTpm(keyName, KeyClass::PUBLIC), false);
 }
 
+BOOST_AUTO_TEST_CASE(DecodedKeyCache)
+{
+  SecTpmFile tpm;
+
+  Name keyName("/TestSecTpmFile/DecodedKeyCache/ksk-" +
+               boost::lexical_cast<std::string>(time::toUnixTimestamp(time::system_clock::now())));
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(keyName, RsaKeyParams(2048)));
+
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+
+  // the second signature uses the decoded key cached by the first one
+  BOOST_CHECK_NO_THROW(tpm.signInTpm(content, sizeof(content), keyName, DigestAlgorithm::SHA256));
+  BOOST_CHECK_NO_THROW(tpm.signInTpm(content, sizeof(content), keyName, DigestAlgorithm::SHA256));
+
+  // deleting the key invalidates the cached key
+  tpm.deleteKeyPairInTpm(keyName);
+  BOOST_CHECK_THROW(tpm.signInTpm(content, sizeof(content), keyName, DigestAlgorithm::SHA256),
+                    SecTpmFile::Error);
+
+  // a new key with the same name, of a different type, is used for subsequent signatures
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(keyName, EcKeyParams()));
+  Block sigBlock;
+  BOOST_REQUIRE_NO_THROW(sigBlock = tpm.signInTpm(content, sizeof(content),
+                                                  keyName, DigestAlgorithm::SHA256));
+  BOOST_CHECK_NO_THROW(tpm.signInTpm(content, sizeof(content), keyName, DigestAlgorithm::SHA256));
+
+  shared_ptr<v1::PublicKey> pubkeyPtr = tpm.getPublicKeyFromTpm(keyName);
+  BOOST_CHECK_EQUAL(pubkeyPtr->getKeyType(), KeyType::EC);
+
+  try
+    {
+      using namespace CryptoPP;
+
+      ECDSA<ECP, SHA256>::PublicKey publicKey;
+      ByteQueue queue;
+      queue.Put(reinterpret_cast<const byte*>(pubkeyPtr->get().buf()), pubkeyPtr->get().size());
+      publicKey.Load(queue);
+
+      uint8_t buffer[64];
+      size_t usedSize = DSAConvertSignatureFormat(buffer, 64, DSA_P1363,
+                                                  sigBlock.value(), sigBlock.value_size(), DSA_DER);
+
+      ECDSA<ECP, SHA256>::Verifier verifier(publicKey);
+      bool result = verifier.VerifyMessage(content, sizeof(content),
+                                           buffer, usedSize);
+
+      BOOST_CHECK_EQUAL(result, true);
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      BOOST_CHECK(false);
+    }
+
+  tpm.deleteKeyPairInTpm(keyName);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSecTpmFile
 BOOST_AUTO_TEST_SUITE_END() // V1
 BOOST_AUTO_TEST_SUITE_END() // Security
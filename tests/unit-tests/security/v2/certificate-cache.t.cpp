@@ -70,6 +70,54 @@ BOOST_AUTO_TEST_CASE(RemovalTime)
   BOOST_CHECK(certCache.find(cert.getName()) == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(FindByName)
+{
+  Certificate cert3 = addCertificate(identity.getDefaultKey(), "3");
+
+  certCache.insert(cert);
+  advanceClocks(time::seconds(5));
+  certCache.insert(cert3);
+
+  BOOST_REQUIRE(certCache.find(cert.getName()) != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find(cert.getName())->getName(), cert.getName());
+  BOOST_REQUIRE(certCache.find(cert3.getName()) != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find(cert3.getName())->getName(), cert3.getName());
+  BOOST_CHECK(certCache.find(Name(cert3.getName()).appendVersion()) == nullptr);
+  BOOST_CHECK(certCache.find(cert.getKeyName()) != nullptr);
+
+  // only the certificate inserted first has expired
+  advanceClocks(time::seconds(6));
+  BOOST_CHECK(certCache.find(cert.getName()) == nullptr);
+  BOOST_REQUIRE(certCache.find(cert.getKeyName()) != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find(cert.getKeyName())->getName(), cert3.getName());
+
+  advanceClocks(time::seconds(5));
+  BOOST_CHECK(certCache.find(cert3.getName()) == nullptr);
+  BOOST_CHECK(certCache.find(cert.getKeyName()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SkipOutdated)
+{
+  // cert3 sorts before cert, and expires first
+  Certificate cert3 = addCertificate(identity.getDefaultKey(), "3");
+  BOOST_REQUIRE_LT(cert3.getName(), cert.getName());
+
+  certCache.insert(cert3);
+  advanceClocks(time::seconds(5));
+  certCache.insert(cert);
+
+  advanceClocks(time::seconds(6));
+  BOOST_CHECK(certCache.find(cert3.getName()) == nullptr);
+  BOOST_REQUIRE(certCache.find(cert.getKeyName()) != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find(cert.getKeyName())->getName(), cert.getName());
+  BOOST_REQUIRE(certCache.find(Interest(cert.getKeyName())) != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find(Interest(cert.getKeyName()))->getName(), cert.getName());
+
+  // an outdated certificate can be inserted again
+  certCache.insert(cert3);
+  BOOST_CHECK(certCache.find(cert3.getName()) != nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(FindByInterest)
 {
   BOOST_CHECK_NO_THROW(certCache.insert(cert));
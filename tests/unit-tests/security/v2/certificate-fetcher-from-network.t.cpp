@@ -128,6 +128,64 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ValidateFailure, T, Failures, CertificateFetche
   BOOST_CHECK_GT(this->face.sentInterests.size(), 2);
 }
 
+BOOST_FIXTURE_TEST_CASE(CoalesceSuccess, CertificateFetcherFromNetworkFixture<Cert>)
+{
+  Data data2("/Security/V2/ValidatorFixture/Sub1/Sub3/Data2");
+  m_keyChain.sign(data2, signingByIdentity("/Security/V2/ValidatorFixture/Sub1/Sub3"));
+
+  size_t nSuccesses = 0;
+  auto onSuccess = [&] (const Data&) { ++nSuccesses; };
+  auto onFailure = [] (const Data&, const ValidationError& error) { BOOST_ERROR(error); };
+  validator.validate(data, onSuccess, onFailure);
+  validator.validate(data2, onSuccess, onFailure);
+  validator.validate(data, onSuccess, onFailure);
+
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nSuccesses, 3);
+  // same Interests as for a single validation
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(CoalesceCallbackException, CertificateFetcherFromNetworkFixture<Cert>)
+{
+  size_t nSuccesses = 0;
+  auto onFailure = [] (const Data&, const ValidationError& error) { BOOST_ERROR(error); };
+  validator.validate(data,
+                     [&] (const Data&) {
+                       ++nSuccesses;
+                       BOOST_THROW_EXCEPTION(std::runtime_error("callback error"));
+                     },
+                     // the state of the throwing validation reports IMPLEMENTATION_ERROR when
+                     // it is destroyed without an outcome
+                     [] (const Data&, const ValidationError&) {});
+  validator.validate(data, [&] (const Data&) { ++nSuccesses; }, onFailure);
+  validator.validate(data, [&] (const Data&) { ++nSuccesses; }, onFailure);
+
+  // the other validations complete before the exception is propagated
+  BOOST_CHECK_THROW(mockNetworkOperations(), std::runtime_error);
+  BOOST_CHECK_EQUAL(nSuccesses, 3);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(CoalesceFailure, T, Failures, CertificateFetcherFromNetworkFixture<T>)
+{
+  size_t nFailures = 0;
+  for (int i = 0; i < 3; ++i) {
+    this->validator.validate(this->data,
+                             [] (const Data&) { BOOST_ERROR("Unexpected success"); },
+                             [&] (const Data&, const ValidationError& error) {
+                               BOOST_CHECK_EQUAL(error.getCode(),
+                                                 ValidationError::Code::CANNOT_RETRIEVE_CERT);
+                               ++nFailures;
+                             });
+  }
+
+  this->mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nFailures, 3);
+  // one Interest and its three retries
+  BOOST_CHECK_EQUAL(this->face.sentInterests.size(), 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCertificateFetcherFromNetwork
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
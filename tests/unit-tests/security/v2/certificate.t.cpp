@@ -22,6 +22,7 @@
  */
 
 #include "security/v2/certificate.hpp"
+#include "security/transform/public-key.hpp"
 
 #include "boost-test.hpp"
 #include "unit-tests/unit-test-time-fixture.hpp"
@@ -187,6 +188,31 @@ BOOST_AUTO_TEST_CASE(Setters)
   BOOST_CHECK_NO_THROW(certificate.getPublicKey());
 }
 
+BOOST_AUTO_TEST_CASE(ParsedPublicKey)
+{
+  Certificate certificate(Block(CERT, sizeof(CERT)));
+
+  auto key = certificate.getParsedPublicKey();
+  BOOST_REQUIRE(key != nullptr);
+  BOOST_CHECK(key->getKeyType() == KeyType::RSA);
+  BOOST_CHECK_EQUAL(certificate.getParsedPublicKey(), key);
+
+  // copies share the decoded key
+  Certificate copy(certificate);
+  BOOST_CHECK_EQUAL(copy.getParsedPublicKey(), key);
+
+  // a new content invalidates the decoded key
+  copy.setContent(PUBLIC_KEY, sizeof(PUBLIC_KEY));
+  auto newKey = copy.getParsedPublicKey();
+  BOOST_REQUIRE(newKey != nullptr);
+  BOOST_CHECK_NE(newKey, key);
+  BOOST_CHECK_EQUAL(certificate.getParsedPublicKey(), key);
+
+  const uint8_t garbage[] = {0x01, 0x02, 0x03};
+  copy.setContent(garbage, sizeof(garbage));
+  BOOST_CHECK(copy.getParsedPublicKey() == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(ValidityPeriodChecking)
 {
   Certificate certificate;
@@ -329,6 +329,143 @@ BOOST_FIXTURE_TEST_CASE(GeneralSigningInterface, IdentityManagementFixture)
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(PreparedSignatureInfoInvalidation, IdentityManagementFixture)
+{
+  auto signAndGetKeyLocator = [this] (const SigningInfo& signingInfo) {
+    Data data("/data");
+    m_keyChain.sign(data, signingInfo);
+    return data.getSignature().getType() == tlv::DigestSha256 ?
+           SigningInfo::getDigestSha256Identity() :
+           data.getSignature().getKeyLocator().getName();
+  };
+
+  // no default identity
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(SigningInfo()), SigningInfo::getDigestSha256Identity());
+
+  Identity id = addIdentity("/id");
+  Key key1 = id.getDefaultKey();
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(SigningInfo()), key1.getName());
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(signingByIdentity("/id")), key1.getName());
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(signingByIdentity("/id")), key1.getName());
+
+  // default key change
+  Key key2 = m_keyChain.createKey(id);
+  m_keyChain.setDefaultKey(id, key2);
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(SigningInfo()), key2.getName());
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(signingByIdentity("/id")), key2.getName());
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(signingByKey(key1.getName())), key1.getName());
+
+  // default identity change
+  Identity id2 = addIdentity("/id2");
+  m_keyChain.setDefaultIdentity(id2);
+  BOOST_CHECK_EQUAL(signAndGetKeyLocator(SigningInfo()), id2.getDefaultKey().getName());
+
+  // key deletion
+  Name key1Name = key1.getName();
+  m_keyChain.deleteKey(id, key1);
+  BOOST_CHECK_THROW(m_keyChain.sign(*make_shared<Data>("/data"), signingByKey(key1Name)),
+                    KeyChain::InvalidSigningInfoError);
+
+  // identity deletion
+  m_keyChain.deleteIdentity(id);
+  BOOST_CHECK_THROW(m_keyChain.sign(*make_shared<Data>("/data"), signingByIdentity("/id")),
+                    KeyChain::InvalidSigningInfoError);
+}
+
+BOOST_FIXTURE_TEST_CASE(SignBatch, IdentityManagementFixture)
+{
+  Identity id = addIdentity("/id");
+  Key key = id.getDefaultKey();
+
+  auto makePackets = [] {
+    std::vector<Data> packets;
+    for (int i = 0; i < 50; ++i) {
+      packets.emplace_back(Name("/data").appendSegment(i));
+      packets.back().setContent(reinterpret_cast<const uint8_t*>(&i), sizeof(i));
+    }
+    return packets;
+  };
+
+  // later calls reuse the signing threads, or start more of them
+  for (size_t nThreads : {0, 1, 4, 2, 8}) {
+    BOOST_TEST_MESSAGE("nThreads=" << nThreads);
+
+    std::vector<Data> packets = makePackets();
+    m_keyChain.signBatch(packets, signingByKey(key), nThreads);
+    for (const Data& data : packets) {
+      BOOST_CHECK_EQUAL(data.getSignature().getType(), tlv::SignatureSha256WithEcdsa);
+      BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), key.getName());
+      BOOST_CHECK(verifySignature(data, key));
+    }
+
+    // DigestSha256 is deterministic, so the result must be identical to signing one by one
+    packets = makePackets();
+    std::vector<Data> expected = makePackets();
+    m_keyChain.signBatch(packets, signingWithSha256(), nThreads);
+    for (size_t i = 0; i < packets.size(); ++i) {
+      m_keyChain.sign(expected[i], signingWithSha256());
+      BOOST_CHECK(packets[i].wireEncode() == expected[i].wireEncode());
+    }
+  }
+
+  std::vector<Data> empty;
+  BOOST_CHECK_NO_THROW(m_keyChain.signBatch(empty, signingByKey(key)));
+
+  std::vector<Data> packets = makePackets();
+  BOOST_CHECK_THROW(m_keyChain.signBatch(packets, signingByIdentity("/non-existing/identity")),
+                    KeyChain::InvalidSigningInfoError);
+}
+
+BOOST_FIXTURE_TEST_CASE(SignWithManifest, IdentityManagementFixture)
+{
+  Identity id = addIdentity("/id");
+  Key key = id.getDefaultKey();
+
+  // 1, 2 and powers of two yield complete trees; the other sizes promote unpaired nodes
+  for (int nPackets : {1, 2, 3, 7, 8, 50}) {
+    BOOST_TEST_MESSAGE("nPackets=" << nPackets);
+
+    std::vector<Data> packets;
+    for (int i = 0; i < nPackets; ++i) {
+      packets.emplace_back(Name("/data").appendSegment(i));
+      packets.back().setContent(reinterpret_cast<const uint8_t*>(&i), sizeof(i));
+    }
+    packets.emplace_back("/data/manifest");
+    m_keyChain.signBatch(packets, signingByKey(key).setManifestSigning(true));
+    Data manifest = packets.back();
+    packets.pop_back();
+
+    BOOST_CHECK_EQUAL(manifest.getSignature().getType(), tlv::SignatureSha256WithEcdsa);
+    BOOST_CHECK(verifySignature(manifest, key));
+    BOOST_CHECK_EQUAL(manifest.getContent().value_size(), 32);
+
+    for (const Data& data : packets) {
+      BOOST_CHECK_EQUAL(data.getSignature().getType(), tlv::SignatureSha256WithMerkleProof);
+      BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), manifest.getName());
+      BOOST_CHECK(verifyMerkleProof(data, manifest));
+
+      // the proof survives a round trip through the wire encoding
+      Data decoded(data.wireEncode());
+      BOOST_CHECK(verifyMerkleProof(decoded, manifest));
+    }
+  }
+
+  // only the manifest
+  std::vector<Data> packets(1, Data("/data/manifest"));
+  BOOST_CHECK_THROW(m_keyChain.signBatch(packets, signingByKey(key).setManifestSigning(true)),
+                    KeyChain::Error);
+
+  packets.emplace(packets.begin(), "/data");
+  BOOST_CHECK_THROW(m_keyChain.signBatch(packets, signingByIdentity("/non-existing/identity")
+                                                    .setManifestSigning(true)),
+                    KeyChain::InvalidSigningInfoError);
+
+  // manifest signing applies only to batches
+  Data data("/data");
+  BOOST_CHECK_THROW(m_keyChain.sign(data, signingByKey(key).setManifestSigning(true)),
+                    KeyChain::InvalidSigningInfoError);
+}
+
 BOOST_FIXTURE_TEST_CASE(PublicKeySigningDefaults, IdentityManagementFixture)
 {
   Data data("/test/data");
@@ -156,6 +156,32 @@ BOOST_AUTO_TEST_CASE(DynamicAnchorFromDir)
   BOOST_CHECK_EQUAL(anchorContainer.getGroup("group").size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Generation)
+{
+  uint64_t generation = anchorContainer.getGeneration();
+
+  anchorContainer.insert("group1", Certificate(cert1));
+  BOOST_CHECK_NE(anchorContainer.getGeneration(), generation);
+  generation = anchorContainer.getGeneration();
+
+  anchorContainer.insert("group1", Certificate(cert1)); // already present
+  BOOST_CHECK_EQUAL(anchorContainer.getGeneration(), generation);
+
+  anchorContainer.insert("group2", certPath2.string(), time::seconds(1));
+  BOOST_CHECK_NE(anchorContainer.getGeneration(), generation);
+  generation = anchorContainer.getGeneration();
+
+  // a refresh that loads the same anchors is not a change
+  advanceClocks(time::seconds(1), 2);
+  BOOST_CHECK_EQUAL(anchorContainer.getGeneration(), generation);
+
+  // a refresh is performed when the generation is requested
+  boost::filesystem::remove(certPath2);
+  advanceClocks(time::seconds(1), 2);
+  BOOST_CHECK_NE(anchorContainer.getGeneration(), generation);
+  BOOST_CHECK_EQUAL(anchorContainer.size(), 1);
+}
+
 BOOST_FIXTURE_TEST_CASE(FindByInterest, AnchorContainerTestFixture)
 {
   anchorContainer.insert("group1", certPath1.string(), time::seconds(1));
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "security/v2/validation-result-cache.hpp"
+#include "data.hpp"
+
+#include "boost-test.hpp"
+#include "../../make-interest-data.hpp"
+#include "../../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_FIXTURE_TEST_SUITE(TestValidationResultCache, UnitTestTimeFixture)
+
+static name::Component
+makeDigest(const std::string& name)
+{
+  return makeData(name)->getFullName().get(-1);
+}
+
+BOOST_AUTO_TEST_CASE(FindInsert)
+{
+  ValidationResultCache cache(10);
+  name::Component digestA = makeDigest("/A");
+  name::Component digestB = makeDigest("/B");
+
+  BOOST_CHECK(cache.find(digestA) == nullptr);
+
+  cache.insert(digestA, ValidationError::Code::NO_ERROR);
+  cache.insert(digestB, {ValidationError::Code::POLICY_ERROR, "rejected"});
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+
+  const ValidationError* outcome = cache.find(digestA);
+  BOOST_REQUIRE(outcome != nullptr);
+  BOOST_CHECK_EQUAL(outcome->getCode(), ValidationError::Code::NO_ERROR);
+
+  outcome = cache.find(digestB);
+  BOOST_REQUIRE(outcome != nullptr);
+  BOOST_CHECK_EQUAL(outcome->getCode(), ValidationError::Code::POLICY_ERROR);
+  BOOST_CHECK_EQUAL(outcome->getInfo(), "rejected");
+
+  // only implicit digests are accepted as keys
+  cache.insert(name::Component("not-a-digest"), ValidationError::Code::NO_ERROR);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find(name::Component("not-a-digest")) == nullptr);
+
+  BOOST_CHECK_EQUAL(cache.getNHits(), 2);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 2);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK(cache.find(digestA) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Lru)
+{
+  ValidationResultCache cache(3);
+  std::vector<name::Component> digests;
+  for (int i = 0; i < 4; ++i) {
+    digests.push_back(makeDigest("/" + to_string(i)));
+  }
+
+  cache.insert(digests[0], ValidationError::Code::NO_ERROR);
+  cache.insert(digests[1], ValidationError::Code::NO_ERROR);
+  cache.insert(digests[2], ValidationError::Code::NO_ERROR);
+  BOOST_CHECK(cache.find(digests[0]) != nullptr); // 0 becomes most recently used
+
+  cache.insert(digests[3], ValidationError::Code::NO_ERROR); // evicts 1
+  BOOST_CHECK_EQUAL(cache.size(), 3);
+  BOOST_CHECK(cache.find(digests[1]) == nullptr);
+  BOOST_CHECK(cache.find(digests[0]) != nullptr);
+  BOOST_CHECK(cache.find(digests[2]) != nullptr);
+  BOOST_CHECK(cache.find(digests[3]) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Expiry)
+{
+  ValidationResultCache cache(10, time::seconds(10));
+  name::Component digestA = makeDigest("/A");
+  name::Component digestB = makeDigest("/B");
+  name::Component digestC = makeDigest("/C");
+
+  cache.insert(digestA, ValidationError::Code::NO_ERROR);
+  cache.insert(digestB, ValidationError::Code::NO_ERROR, time::system_clock::now() + time::seconds(5));
+  cache.insert(digestC, ValidationError::Code::NO_ERROR, time::system_clock::now() - time::seconds(1));
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find(digestC) == nullptr);
+
+  advanceClocks(time::seconds(6));
+  BOOST_CHECK(cache.find(digestA) != nullptr);
+  BOOST_CHECK(cache.find(digestB) == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  advanceClocks(time::seconds(5));
+  BOOST_CHECK(cache.find(digestA) == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestValidationResultCache
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
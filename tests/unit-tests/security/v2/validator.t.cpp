@@ -25,6 +25,8 @@
 #include "boost-test.hpp"
 #include "validator-fixture.hpp"
 
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -32,6 +34,18 @@ namespace tests {
 
 using namespace ndn::tests;
 
+/**
+ * @brief Sign @p packets with @p manifest in the manifest signing mode of KeyChain::signBatch
+ */
+static void
+signWithManifest(KeyChain& keyChain, std::vector<Data>& packets, Data& manifest, SigningInfo params)
+{
+  packets.push_back(manifest);
+  keyChain.signBatch(packets, params.setManifestSigning(true));
+  manifest = packets.back();
+  packets.pop_back();
+}
+
 BOOST_AUTO_TEST_SUITE(Security)
 BOOST_AUTO_TEST_SUITE(V2)
 BOOST_FIXTURE_TEST_SUITE(TestValidator, HierarchicalValidatorFixture<ValidationPolicySimpleHierarchy>)
@@ -267,6 +281,361 @@ BOOST_AUTO_TEST_CASE(LoopingCert)
   BOOST_CHECK_EQUAL(face.sentInterests.size(), 30);
 }
 
+BOOST_AUTO_TEST_CASE(VerifyOnExecutor)
+{
+  validator.setVerificationExecutor(make_unique<VerificationExecutor>(io, 2));
+
+  auto validateOnExecutor = [this] (const Data& data, bool expectSuccess) {
+    size_t nCallbacks = 0;
+    validator.validate(data,
+                       [&] (const Data&) {
+                         ++nCallbacks;
+                         BOOST_CHECK(expectSuccess);
+                       },
+                       [&] (const Data&, const ValidationError&) {
+                         ++nCallbacks;
+                         BOOST_CHECK(!expectSuccess);
+                       });
+    mockNetworkOperations();
+    // the outcome is posted to io once the worker thread is done
+    while (nCallbacks == 0) {
+      if (io.stopped())
+        io.reset();
+      io.run_one();
+    }
+    BOOST_CHECK_EQUAL(nCallbacks, 1);
+  };
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+  validateOnExecutor(data, true);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+
+  // the certificate verified on the worker thread has been cached
+  face.sentInterests.clear();
+  validateOnExecutor(data, true);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  Data badSigData = data;
+  badSigData.setContent(data.wireEncode().value(), 10);
+  validateOnExecutor(badSigData, false);
+
+  validator.setVerificationExecutor(nullptr);
+  VALIDATE_SUCCESS(data, "Should get accepted, as verification is synchronous again");
+}
+
+BOOST_AUTO_TEST_CASE(ResultCache)
+{
+  validator.setValidationResultCache(make_unique<ValidationResultCache>(100));
+  const ValidationResultCache& resultCache = *validator.getValidationResultCache();
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the policy-compliant cert");
+  BOOST_CHECK_EQUAL(resultCache.size(), 1);
+  BOOST_CHECK_EQUAL(resultCache.getNMisses(), 1);
+
+  processInterest = nullptr; // disable data responses from mocked network
+  face.sentInterests.clear();
+  VALIDATE_SUCCESS(data, "Should get accepted, based on the cached outcome");
+  BOOST_CHECK_EQUAL(resultCache.getNHits(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  // same name, different bytes
+  Data otherData("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  otherData.setContent(data.wireEncode().value(), 10);
+  m_keyChain.sign(otherData, signingByIdentity(subIdentity));
+  VALIDATE_SUCCESS(otherData, "Should get accepted, based on the cached trusted cert");
+  BOOST_CHECK_EQUAL(resultCache.getNMisses(), 2);
+
+  Data policyViolatingData("/Security/V2/ValidatorFixture/Data");
+  m_keyChain.sign(policyViolatingData, signingByIdentity(subIdentity));
+  VALIDATE_FAILURE(policyViolatingData, "Should fail, as signed by a cert that is not a prefix of the name");
+  VALIDATE_FAILURE(policyViolatingData, "Should fail, based on the cached outcome");
+  BOOST_CHECK_EQUAL(resultCache.getNHits(), 2);
+
+  // failures to retrieve certificates are not cached
+  Data unretrievableData("/Security/V2/ValidatorFixture/Sub1/Sub3/Data");
+  Identity otherSubIdentity = addSubCertificate("/Security/V2/ValidatorFixture/Sub1/Sub3", identity);
+  m_keyChain.sign(unretrievableData, signingByIdentity(otherSubIdentity));
+  VALIDATE_FAILURE(unretrievableData, "Should fail to retrieve certificate");
+  BOOST_CHECK_EQUAL(resultCache.size(), 3);
+
+  // cached outcomes expire after the maximum lifetime
+  advanceClocks(time::hours(1), 2);
+  VALIDATE_FAILURE(data, "Should try and fail to retrieve certs");
+  BOOST_CHECK_EQUAL(resultCache.getNHits(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ResultCacheCertificateExpiry)
+{
+  validator.setValidationResultCache(make_unique<ValidationResultCache>(100));
+  const ValidationResultCache& resultCache = *validator.getValidationResultCache();
+
+  // a certificate that expires in 10 minutes
+  Identity shortLivedIdentity = addIdentity("/Security/V2/ValidatorFixture/ShortLived");
+  Key key = shortLivedIdentity.getDefaultKey();
+  Certificate cert;
+  cert.setName(Name(key.getName()).append("parent").appendVersion());
+  cert.setContentType(tlv::ContentType_Key);
+  cert.setFreshnessPeriod(time::hours(1));
+  cert.setContent(key.getPublicKey().buf(), key.getPublicKey().size());
+  SignatureInfo info;
+  info.setValidityPeriod(security::ValidityPeriod(time::system_clock::now() - time::days(1),
+                                                  time::system_clock::now() + time::minutes(10)));
+  m_keyChain.sign(cert, signingByIdentity(identity).setSignatureInfo(info));
+  cache.insert(cert);
+
+  Data data("/Security/V2/ValidatorFixture/ShortLived/Data");
+  m_keyChain.sign(data, signingByKey(key));
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the policy-compliant cert");
+  BOOST_CHECK_EQUAL(resultCache.size(), 1);
+
+  VALIDATE_SUCCESS(data, "Should get accepted, based on the cached outcome");
+  BOOST_CHECK_EQUAL(resultCache.getNHits(), 1);
+
+  advanceClocks(time::minutes(10));
+  VALIDATE_FAILURE(data, "Should fail, as the certificate has expired");
+  BOOST_CHECK_EQUAL(resultCache.getNHits(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ResultCacheAnchorChange)
+{
+  validator.setValidationResultCache(make_unique<ValidationResultCache>(100));
+  const ValidationResultCache& resultCache = *validator.getValidationResultCache();
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the policy-compliant cert");
+  BOOST_CHECK_EQUAL(resultCache.size(), 1);
+
+  validator.loadAnchor("other", Certificate(otherIdentity.getDefaultKey().getDefaultCertificate()));
+  VALIDATE_SUCCESS(data, "Should get accepted, based on the cached trusted cert");
+  BOOST_CHECK_EQUAL(resultCache.getNHits(), 0);
+  BOOST_CHECK_EQUAL(resultCache.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ResultCacheRetrievedCertPolicyError)
+{
+  validator.setValidationResultCache(make_unique<ValidationResultCache>(100));
+  const ValidationResultCache& resultCache = *validator.getValidationResultCache();
+
+  // a certificate that violates the policy, as its signer is not a prefix of its name
+  Identity sub3Identity = addIdentity("/Security/V2/ValidatorFixture/Sub1/Sub3");
+  Key key = sub3Identity.getDefaultKey();
+  Certificate cert;
+  cert.setName(Name(key.getName()).append("parent").appendVersion());
+  cert.setContentType(tlv::ContentType_Key);
+  cert.setFreshnessPeriod(time::hours(1));
+  cert.setContent(key.getPublicKey().buf(), key.getPublicKey().size());
+  SignatureInfo info;
+  info.setValidityPeriod(security::ValidityPeriod(time::system_clock::now() - time::days(1),
+                                                  time::system_clock::now() + time::days(1)));
+  m_keyChain.sign(cert, signingByIdentity(otherIdentity).setSignatureInfo(info));
+  cache.insert(cert);
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub3/Data");
+  m_keyChain.sign(data, signingByKey(key));
+  VALIDATE_FAILURE(data, "Should fail, as the retrieved cert violates the policy");
+  BOOST_CHECK_EQUAL(resultCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Manifest)
+{
+  std::vector<Data> packets;
+  for (int i = 0; i < 5; ++i) {
+    packets.emplace_back(Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data").appendSegment(i));
+  }
+  Data manifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  manifest.setFreshnessPeriod(time::hours(1));
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(subIdentity));
+
+  VALIDATE_FAILURE(packets[0], "Should fail, as the manifest has not been validated yet");
+
+  size_t nCallbacks = 0;
+  validator.validateManifest(manifest,
+                             [&] (const Data&) { ++nCallbacks; },
+                             [&] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+
+  face.sentInterests.clear();
+  for (const Data& data : packets) {
+    VALIDATE_SUCCESS(data, "Should get accepted, as the manifest has been validated");
+  }
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  Data tampered = packets[1];
+  tampered.setContent(manifest.getContent().value(), manifest.getContent().value_size());
+  VALIDATE_FAILURE(tampered, "Should fail, as the content has been changed");
+
+  Data invalidManifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest2");
+  std::vector<Data> otherPackets(1, Data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data2"));
+  signWithManifest(m_keyChain, otherPackets, invalidManifest, signingByIdentity(otherIdentity));
+  validator.validateManifest(invalidManifest,
+                             [&] (const Data&) { BOOST_ERROR("Unexpected success"); },
+                             [&] (const Data&, const ValidationError&) { ++nCallbacks; });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 2);
+  VALIDATE_FAILURE(otherPackets[0], "Should fail, as the manifest did not pass validation");
+
+  advanceClocks(time::hours(1), 2); // expire the validated manifest
+  VALIDATE_FAILURE(packets[0], "Should fail, as the manifest is no longer remembered");
+}
+
+BOOST_AUTO_TEST_CASE(ManifestNotValidated)
+{
+  std::vector<Data> packets(1, Data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data"));
+  Data manifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(subIdentity));
+
+  size_t nFailures = 0;
+  validator.validate(packets[0],
+                     [] (const Data&) { BOOST_ERROR("Unexpected success"); },
+                     [&] (const Data&, const ValidationError& error) {
+                       BOOST_CHECK_EQUAL(error.getCode(), ValidationError::Code::INVALID_KEY_LOCATOR);
+                       ++nFailures;
+                     });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nFailures, 1);
+  // the manifest is not fetched
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  validator.validateManifest(manifest,
+                             [] (const Data&) {},
+                             [&] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  mockNetworkOperations();
+  VALIDATE_SUCCESS(packets[0], "Should get accepted, as the manifest has been validated");
+}
+
+BOOST_AUTO_TEST_CASE(ManifestForeignNamespace)
+{
+  // the signer of the manifest is not allowed to sign the packet
+  std::vector<Data> packets(1, Data("/Security/V2/ValidatorFixture/Sub3/Data"));
+  Data manifest("/Security/V2/ValidatorFixture/Sub1/Manifest");
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(subIdentity));
+
+  size_t nCallbacks = 0;
+  validator.validateManifest(manifest,
+                             [&] (const Data&) { ++nCallbacks; },
+                             [&] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+
+  VALIDATE_FAILURE(packets[0], "Should fail, as the packet is outside the namespace of the manifest signer");
+}
+
+BOOST_AUTO_TEST_CASE(ManifestForgedProof)
+{
+  std::vector<Data> packets;
+  for (int i = 0; i < 4; ++i) {
+    packets.emplace_back(Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data").appendSegment(i));
+  }
+  Data manifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(subIdentity));
+
+  size_t nCallbacks = 0;
+  validator.validateManifest(manifest,
+                             [&] (const Data&) { ++nCallbacks; },
+                             [&] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+  VALIDATE_SUCCESS(packets[0], "Should get accepted, as the manifest has been validated");
+
+  // proof of another leaf
+  Data forged = packets[0];
+  forged.setSignatureValue(packets[1].getSignature().getValue());
+  VALIDATE_FAILURE(forged, "Should fail, as the proof belongs to another packet");
+
+  // proof with a flipped bit
+  Buffer proof(packets[0].getSignature().getValue().value(),
+               packets[0].getSignature().getValue().value_size());
+  proof[proof.size() - 1] ^= 0x01;
+  forged = packets[0];
+  forged.setSignatureValue(makeBinaryBlock(tlv::SignatureValue, proof.data(), proof.size()));
+  VALIDATE_FAILURE(forged, "Should fail, as the proof has been altered");
+
+  // proof against another manifest under the same name, which has not been validated
+  std::vector<Data> otherPackets(1, Data("/Security/V2/ValidatorFixture/Sub1/Sub2/Forged"));
+  Data otherManifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  signWithManifest(m_keyChain, otherPackets, otherManifest, signingWithSha256());
+  VALIDATE_FAILURE(otherPackets[0], "Should fail, as the proof does not lead to the validated root");
+}
+
+BOOST_AUTO_TEST_CASE(ManifestUntrustedSigner)
+{
+  // the signer is in the right namespace, but its certificate is self-signed
+  std::vector<Data> packets(1, Data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data"));
+  Data manifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(subSelfSignedIdentity));
+
+  size_t nCallbacks = 0;
+  validator.validateManifest(manifest,
+                             [&] (const Data&) { BOOST_ERROR("Unexpected success"); },
+                             [&] (const Data&, const ValidationError&) { ++nCallbacks; });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+  VALIDATE_FAILURE(packets[0], "Should fail, as the manifest signer is not trusted");
+
+  // a manifest with a forged signature
+  Data forgedManifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  signWithManifest(m_keyChain, packets, forgedManifest, signingByIdentity(subSelfSignedIdentity));
+  forgedManifest.setSignature(Signature(SignatureInfo(tlv::SignatureSha256WithEcdsa,
+                                                      subIdentity.getDefaultKey().getDefaultCertificate()
+                                                        .getName()),
+                                        forgedManifest.getSignature().getValue()));
+  validator.validateManifest(forgedManifest,
+                             [&] (const Data&) { BOOST_ERROR("Unexpected success"); },
+                             [&] (const Data&, const ValidationError&) { ++nCallbacks; });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 2);
+  VALIDATE_FAILURE(packets[0], "Should fail, as the manifest signature is forged");
+}
+
+BOOST_AUTO_TEST_CASE(ManifestWithoutFreshnessPeriod)
+{
+  std::vector<Data> packets(1, Data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data"));
+  Data manifest("/Security/V2/ValidatorFixture/Sub1/Sub2/Manifest");
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(subIdentity));
+
+  size_t nCallbacks = 0;
+  validator.validateManifest(manifest,
+                             [&] (const Data&) { ++nCallbacks; },
+                             [&] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+  VALIDATE_SUCCESS(packets[0], "Should get accepted, as the manifest has been validated");
+
+  advanceClocks(Validator::MAX_MANIFEST_LIFETIME);
+  VALIDATE_FAILURE(packets[0], "Should fail, as the manifest is remembered no longer than the maximum");
+}
+
+BOOST_AUTO_TEST_CASE(ManifestAnchorRemoval)
+{
+  boost::filesystem::path anchorPath = boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "manifest-anchor.cert";
+  boost::filesystem::create_directories(anchorPath.parent_path());
+  Identity anchorIdentity = addIdentity("/Security/V2/ManifestAnchor");
+  saveCertToFile(anchorIdentity.getDefaultKey().getDefaultCertificate(), anchorPath.string());
+  validator.loadAnchor("manifest-anchor", anchorPath.string(), time::seconds(1));
+
+  std::vector<Data> packets(1, Data("/Security/V2/ManifestAnchor/Data"));
+  Data manifest("/Security/V2/ManifestAnchor/Manifest");
+  manifest.setFreshnessPeriod(time::hours(1));
+  signWithManifest(m_keyChain, packets, manifest, signingByIdentity(anchorIdentity));
+
+  size_t nCallbacks = 0;
+  validator.validateManifest(manifest,
+                             [&] (const Data&) { ++nCallbacks; },
+                             [&] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+  VALIDATE_SUCCESS(packets[0], "Should get accepted, as the manifest has been validated");
+
+  boost::filesystem::remove(anchorPath);
+  advanceClocks(time::seconds(1), 2);
+  VALIDATE_FAILURE(packets[0], "Should fail, as the anchor that validated the manifest is gone");
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestValidator
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
@@ -653,6 +653,62 @@ BOOST_AUTO_TEST_CASE(Reset)
   BOOST_CHECK(validator.isEmpty());
 }
 
+BOOST_AUTO_TEST_CASE(ReloadKeepsConfigOnError)
+{
+  const std::string CONFIG =
+    "rule\n"
+    "{\n"
+    "  id \"Data Rule\"\n"
+    "  for data\n"
+    "  filter\n"
+    "  {\n"
+    "    type name\n"
+    "    regex ^<TestValidatorConfig><Reload><>$\n"
+    "  }\n"
+    "  checker\n"
+    "  {\n"
+    "    type hierarchical\n"
+    "    sig-type rsa-sha256\n"
+    "  }\n"
+    "}\n";
+  const std::string BAD_CONFIG =
+    "rule\n"
+    "{\n"
+    "  id \"Another Data Rule\"\n"
+    "  for data\n"
+    "  filter\n"
+    "  {\n"
+    "    type name\n"
+    "    name /TestValidatorConfig\n"
+    "    relation is-prefix-of\n"
+    "  }\n"
+    "  checker\n"
+    "  {\n"
+    "    type hierarchical\n"
+    "    sig-type rsa-sha256\n"
+    "  }\n"
+    "}\n"
+    "rule\n"
+    "{\n"
+    "  id \"Rule Without Checker\"\n"
+    "  for data\n"
+    "}\n";
+  const boost::filesystem::path CONFIG_PATH =
+    (boost::filesystem::current_path() / std::string("unit-test-reload.conf"));
+
+  validator.load(CONFIG, CONFIG_PATH.c_str());
+  BOOST_REQUIRE_EQUAL(validator.m_dataRules.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_dataRuleIndex.size(), 1);
+  auto rule = validator.m_dataRules.front();
+
+  BOOST_CHECK_THROW(validator.load(BAD_CONFIG, CONFIG_PATH.c_str()), security::conf::Error);
+  BOOST_REQUIRE_EQUAL(validator.m_dataRules.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_dataRules.front(), rule);
+  BOOST_CHECK_EQUAL(validator.m_dataRuleIndex.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_dataRuleIndex.findFirstMatch(Data("/TestValidatorConfig/Reload/A")), rule);
+  BOOST_CHECK(validator.m_dataRuleIndex.findFirstMatch(Data("/TestValidatorConfig/A")) == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(TrustAnchorWildcard)
 {
   Name identity("/TestValidatorConfig/Wildcard");
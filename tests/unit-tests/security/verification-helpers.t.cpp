@@ -496,6 +496,52 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(VerifyDigest, Dataset, DigestDatasets)
   // - base version of verifyDigest is tested transitively
 }
 
+BOOST_FIXTURE_TEST_CASE(VerifyMerkleProof, IdentityManagementFixture)
+{
+  std::vector<Data> packets;
+  for (int i = 0; i < 5; ++i) {
+    packets.emplace_back(Name("/some/data").appendSegment(i));
+  }
+  packets.emplace_back("/some/manifest");
+  m_keyChain.signBatch(packets, signingWithSha256().setManifestSigning(true));
+  Data manifest = packets.back();
+  packets.pop_back();
+
+  for (const Data& data : packets) {
+    BOOST_CHECK(verifyMerkleProof(data, manifest));
+    BOOST_CHECK(verifyMerkleProof(data, manifest.getContent().value(), manifest.getContent().value_size()));
+  }
+
+  // content changed after signing
+  Data badContentData = packets[0];
+  badContentData.setContent(manifest.getContent().value(), manifest.getContent().value_size());
+  BOOST_CHECK(!verifyMerkleProof(badContentData, manifest));
+
+  // proof of another leaf
+  Data badProofData = packets[0];
+  badProofData.setSignatureValue(packets[1].getSignature().getValue());
+  BOOST_CHECK(!verifyMerkleProof(badProofData, manifest));
+
+  // truncated proof
+  Data truncatedProofData = packets[0];
+  const Block& proof = packets[0].getSignature().getValue();
+  truncatedProofData.setSignatureValue(makeBinaryBlock(tlv::SignatureValue, proof.value(),
+                                                       proof.value_size() - 1));
+  BOOST_CHECK(!verifyMerkleProof(truncatedProofData, manifest));
+
+  // manifest with a different name or root
+  Data otherManifest("/some/other/manifest");
+  otherManifest.setContent(manifest.getContent());
+  BOOST_CHECK(!verifyMerkleProof(packets[0], otherManifest));
+  Data badRootManifest("/some/manifest");
+  badRootManifest.setContent(manifest.getContent().value(), manifest.getContent().value_size() - 1);
+  BOOST_CHECK(!verifyMerkleProof(packets[0], badRootManifest));
+
+  // not signed with a Merkle proof
+  BOOST_CHECK(!verifyMerkleProof(manifest, manifest));
+  BOOST_CHECK(!verifyMerkleProof(Data("/some/data"), manifest));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestVerificationHelpers
 BOOST_AUTO_TEST_SUITE_END() // Security
 
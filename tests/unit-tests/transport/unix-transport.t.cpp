@@ -21,6 +21,11 @@
 
 #include "transport/unix-transport.hpp"
 #include "transport-fixture.hpp"
+#include "interest.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
 
 #include "boost-test.hpp"
 
@@ -61,6 +66,157 @@ BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadMalformedUri)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(CoalesceWrites)
+{
+  boost::asio::io_service io;
+  boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  const std::string socketPath = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) /
+                                  "unix-transport.sock").string();
+  boost::filesystem::remove(socketPath);
+  boost::asio::local::stream_protocol::acceptor acceptor(io,
+    boost::asio::local::stream_protocol::endpoint(socketPath));
+  boost::asio::local::stream_protocol::socket peer(io);
+  UnixTransport transport(socketPath);
+  transport.connect(io, [] (const Block&) {});
+  transport.setWriteBatchLimits(Transport::DEFAULT_MAX_WRITE_BATCH_BYTES, 10);
+
+  // packets sent while connecting are queued, and then written in batches of 10
+  const size_t nPackets = 100;
+  size_t nBytes = 0;
+  for (size_t i = 0; i < nPackets; ++i) {
+    Interest interest(Name("/A").appendNumber(i));
+    interest.setNonce(static_cast<uint32_t>(i));
+    transport.send(interest.wireEncode());
+    nBytes += interest.wireEncode().size();
+  }
+
+  std::vector<uint8_t> received(nBytes);
+  acceptor.async_accept(peer, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    boost::asio::async_read(peer, boost::asio::buffer(received),
+      [&] (const boost::system::error_code& error, size_t) {
+        BOOST_REQUIRE(!error);
+        transport.close();
+      });
+  });
+  io.run();
+
+  const Transport::WriteCounters& counters = transport.getWriteCounters();
+  BOOST_CHECK_EQUAL(counters.nOutPackets, nPackets);
+  BOOST_CHECK_EQUAL(counters.nOutBytes, nBytes);
+  BOOST_CHECK_GE(counters.nWriteOps, nPackets / 10);
+  BOOST_CHECK_LT(counters.nWriteOps, nPackets);
+  BOOST_CHECK_GE(counters.getAverageBatchSize(), 1.0);
+
+  Block firstPacket(received.data(), received.size());
+  BOOST_CHECK_EQUAL(Interest(firstPacket).getName(), Name("/A").appendNumber(0));
+
+  boost::filesystem::remove_all(UNIT_TEST_CONFIG_PATH);
+}
+
+class ReceiveFixture : public TransportFixture
+{
+public:
+  ReceiveFixture()
+    : socketPath((boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "unix-transport.sock").string())
+    , peer(io)
+    , transport(socketPath)
+  {
+    boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+    boost::filesystem::remove(socketPath);
+    acceptor = make_unique<boost::asio::local::stream_protocol::acceptor>(io,
+                 boost::asio::local::stream_protocol::endpoint(socketPath));
+  }
+
+  ~ReceiveFixture()
+  {
+    boost::filesystem::remove_all(UNIT_TEST_CONFIG_PATH);
+  }
+
+  /** \brief connects the transport, and writes \p wire from the peer after it is accepted
+   */
+  void
+  sendFromPeer(const std::vector<uint8_t>& wire)
+  {
+    transport.connect(io, [this] (const Block& block) {
+      received.push_back(block);
+      io.stop();
+    });
+
+    acceptor->async_accept(peer, [this, &wire] (const boost::system::error_code& error) {
+      BOOST_REQUIRE(!error);
+      boost::asio::write(peer, boost::asio::buffer(wire));
+    });
+  }
+
+public:
+  boost::asio::io_service io;
+  const std::string socketPath;
+  unique_ptr<boost::asio::local::stream_protocol::acceptor> acceptor;
+  boost::asio::local::stream_protocol::socket peer;
+  UnixTransport transport;
+  std::vector<Block> received;
+};
+
+BOOST_FIXTURE_TEST_CASE(ReceiveSmallPacket, ReceiveFixture)
+{
+  Block wire = Interest("/A").setNonce(1).wireEncode();
+  std::vector<uint8_t> bytes(wire.begin(), wire.end());
+  sendFromPeer(bytes);
+  io.run();
+
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK(received[0] == wire);
+  // a small packet does not pin the receive chunk
+  BOOST_CHECK_LT(received[0].getBuffer()->size(), MAX_NDN_PACKET_SIZE);
+}
+
+BOOST_FIXTURE_TEST_CASE(ReceiveSmallPackets, ReceiveFixture)
+{
+  Block wire1 = Interest("/A").setNonce(1).wireEncode();
+  Block wire2 = Interest("/B").setNonce(2).wireEncode();
+  std::vector<uint8_t> bytes(wire1.begin(), wire1.end());
+  bytes.insert(bytes.end(), wire2.begin(), wire2.end());
+  sendFromPeer(bytes);
+  while (received.size() < 2) {
+    io.reset();
+    io.run();
+  }
+
+  BOOST_REQUIRE_EQUAL(received.size(), 2);
+  BOOST_CHECK(received[0] == wire1);
+  BOOST_CHECK(received[1] == wire2);
+  // consecutive small packets are copied into the same slab
+  BOOST_CHECK(received[0].getBuffer() == received[1].getBuffer());
+}
+
+BOOST_FIXTURE_TEST_CASE(ReceiveLargePacket, ReceiveFixture)
+{
+  std::vector<uint8_t> value(MAX_NDN_PACKET_SIZE - 4, 0xaa);
+  Block wire = makeBinaryBlock(tlv::Data, value.data(), value.size());
+  BOOST_REQUIRE_EQUAL(wire.size(), MAX_NDN_PACKET_SIZE);
+  std::vector<uint8_t> bytes(wire.begin(), wire.end());
+  sendFromPeer(bytes);
+  io.run();
+
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK(received[0] == wire);
+  // a large packet shares the receive chunk
+  BOOST_CHECK_GT(received[0].getBuffer()->size(), wire.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(ReceiveOversizedPacket, ReceiveFixture)
+{
+  std::vector<uint8_t> value(MAX_NDN_PACKET_SIZE - 3, 0xaa);
+  Block wire = makeBinaryBlock(tlv::Data, value.data(), value.size());
+  BOOST_REQUIRE_EQUAL(wire.size(), MAX_NDN_PACKET_SIZE + 1);
+  std::vector<uint8_t> bytes(wire.begin(), wire.end());
+  sendFromPeer(bytes);
+
+  BOOST_CHECK_THROW(io.run(), Transport::Error);
+  BOOST_CHECK(received.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnixTransport
 BOOST_AUTO_TEST_SUITE_END() // Transport
 
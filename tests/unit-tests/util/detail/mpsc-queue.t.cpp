@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/detail/mpsc-queue.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace detail {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(Detail)
+BOOST_AUTO_TEST_SUITE(TestMpscQueue)
+
+BOOST_AUTO_TEST_CASE(Fifo)
+{
+  MpscQueue<int> queue;
+  int value = 0;
+  BOOST_CHECK_EQUAL(queue.pop(value), false);
+
+  queue.push(1);
+  queue.push(2);
+  BOOST_CHECK_EQUAL(queue.pop(value), true);
+  BOOST_CHECK_EQUAL(value, 1);
+  queue.push(3);
+  BOOST_CHECK_EQUAL(queue.pop(value), true);
+  BOOST_CHECK_EQUAL(value, 2);
+  BOOST_CHECK_EQUAL(queue.pop(value), true);
+  BOOST_CHECK_EQUAL(value, 3);
+  BOOST_CHECK_EQUAL(queue.pop(value), false);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyNonEmpty)
+{
+  auto value = make_shared<int>(1);
+  {
+    MpscQueue<shared_ptr<int>> queue;
+    queue.push(value);
+    queue.push(value);
+    BOOST_CHECK_EQUAL(value.use_count(), 3);
+  }
+  BOOST_CHECK_EQUAL(value.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentProducers)
+{
+  const uint64_t nProducers = 8;
+  const uint64_t nValuesPerProducer = 100000;
+
+  MpscQueue<uint64_t> queue;
+  std::vector<std::thread> producers;
+  for (uint64_t i = 0; i < nProducers; ++i) {
+    producers.emplace_back([&queue, i, nValuesPerProducer] {
+      for (uint64_t j = 0; j < nValuesPerProducer; ++j) {
+        queue.push(i * nValuesPerProducer + j);
+      }
+    });
+  }
+
+  // the consumer runs concurrently with the producers
+  std::vector<uint64_t> nextValue(nProducers, 0);
+  uint64_t nPopped = 0;
+  uint64_t nOutOfOrder = 0;
+  uint64_t value = 0;
+  while (nPopped < nProducers * nValuesPerProducer) {
+    if (!queue.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ++nPopped;
+
+    // values from the same producer are popped in order
+    uint64_t producer = value / nValuesPerProducer;
+    BOOST_REQUIRE_LT(producer, nProducers);
+    if (value % nValuesPerProducer != nextValue[producer]++) {
+      ++nOutOfOrder;
+    }
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  BOOST_CHECK_EQUAL(nOutOfOrder, 0);
+  BOOST_CHECK_EQUAL(queue.pop(value), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMpscQueue
+BOOST_AUTO_TEST_SUITE_END() // Detail
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace detail
+} // namespace util
+} // namespace ndn
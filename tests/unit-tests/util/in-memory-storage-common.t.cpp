@@ -1049,6 +1049,64 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   BOOST_CHECK_EQUAL(find(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ExactNameMustBeFresh)
+{
+  Name n1 = insert(1, "ndn:/A", time::milliseconds(500));
+  Name n2 = insert(2, "ndn:/A");
+  insert(3, "ndn:/A/B");
+  uint32_t leftmost = n1 < n2 ? 1 : 2;
+
+  startInterest("ndn:/A");
+  BOOST_CHECK_EQUAL(find(), leftmost);
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), leftmost);
+
+  advanceClocks(time::milliseconds(1000));
+  // @1s, n1 is stale
+  startInterest("ndn:/A");
+  BOOST_CHECK_EQUAL(find(), leftmost);
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 2);
+
+  // an exact-name match that does not satisfy the selectors is skipped
+  startInterest("ndn:/A")
+    .setMinSuffixComponents(2);
+  BOOST_CHECK_EQUAL(find(), 3);
+
+  m_ims.erase(n2, false);
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(MustBeFreshManyStale)
+{
+  for (uint32_t i = 1; i < 100; ++i) {
+    insert(i, Name("ndn:/A").appendNumber(i), time::milliseconds(500));
+  }
+  insert(100, Name("ndn:/A").appendNumber(100));
+  insert(101, Name("ndn:/B").appendNumber(1), time::milliseconds(500));
+
+  advanceClocks(time::milliseconds(1000));
+  // @1s, only /A/100 is fresh
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 100);
+  startInterest("ndn:/A")
+    .setMustBeFresh(false);
+  BOOST_CHECK_EQUAL(find(), 1);
+  startInterest("ndn:/B")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 0);
+
+  m_ims.erase(Name("ndn:/A").appendNumber(100));
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 BOOST_AUTO_TEST_SUITE_END() // Common
 BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorage
@@ -439,6 +439,67 @@ BOOST_AUTO_TEST_CASE(TopMatcherAdvanced)
   BOOST_CHECK_EQUAL(cm->expand(), Name("/ndn/edu/ucla/yingdi/mac/"));
 }
 
+BOOST_AUTO_TEST_CASE(AutomatonAgreesWithBacktracking)
+{
+  const std::vector<std::string> exprs{
+    "^<a>",
+    "^<a>$",
+    "<b><c>",
+    "^<a>*<b>+<c>?$",
+    "^<a>{2}<b>{,2}<c>{1,}$",
+    "^[<a><b>]{1,3}[^<c>]$",
+    "^(<a><b>)*<a>?$",
+    "^(<.*>*)<.*>",
+    "<a>(<>*)<>$",
+    "^<ndn><(.*)\\.(.*)><DNS>(<>*)<>",
+  };
+  const std::vector<Name> names{
+    "/", "/a", "/b", "/c", "/a/b", "/a/a/b/c", "/a/a/b/b/c/c", "/a/b/a/b/a", "/a/b/a/b/b",
+    "/b/a/c", "/b/a/d", "/n/a/b/c", "/ndn/ucla.edu/DNS/yingdi/mac/ksk-1", "/ndn/ucla/DNS/x",
+  };
+
+  for (const auto& expr : exprs) {
+    Regex automaton(expr);
+    Regex backtracking(expr);
+    for (const auto& name : names) {
+      BOOST_TEST_CONTEXT(expr << " " << name) {
+        bool isMatched = automaton.match(name);
+        BOOST_CHECK_EQUAL(isMatched, backtracking.matchByBacktracking(name));
+        if (isMatched) {
+          BOOST_CHECK_EQUAL_COLLECTIONS(automaton.getMatchResult().begin(),
+                                        automaton.getMatchResult().end(),
+                                        backtracking.getMatchResult().begin(),
+                                        backtracking.getMatchResult().end());
+          BOOST_CHECK_EQUAL(automaton.expand("\\0"), backtracking.expand("\\0"));
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AutomatonNestedRepetition)
+{
+  // backtracking takes exponential time on such expressions
+  Regex regex("^(<a>*)*<b>$");
+  Name name;
+  for (int i = 0; i < 64; ++i) {
+    name.append("a");
+  }
+  BOOST_CHECK_EQUAL(regex.match(name), false);
+  BOOST_CHECK_EQUAL(regex.match(Name(name).append("b")), true);
+}
+
+BOOST_AUTO_TEST_CASE(Copy)
+{
+  Regex regex("^<ndn>(<>)<KEY>$", "\\1");
+  Regex copy(regex);
+  BOOST_CHECK_EQUAL(copy.match("/ndn/alice/KEY"), true);
+  BOOST_CHECK_EQUAL(copy.expand(), "/alice");
+  BOOST_CHECK_EQUAL(copy.match("/ndn/alice/bob/KEY"), false);
+  BOOST_CHECK_EQUAL(regex.match("/ndn/bob/KEY"), true);
+  BOOST_CHECK_EQUAL(regex.expand(), "/bob");
+}
+
 BOOST_AUTO_TEST_CASE(RegexBackrefManagerMemoryLeak)
 {
   auto re = make_unique<Regex>("^(<>)$");
@@ -25,6 +25,9 @@
 #include "boost-test.hpp"
 #include "../unit-test-time-fixture.hpp"
 #include <boost/lexical_cast.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <thread>
 
 namespace ndn {
 namespace util {
@@ -243,6 +246,94 @@ BOOST_AUTO_TEST_CASE(CancelAllWithScopedEventId) // Bug 3691
   BOOST_CHECK(true);
 }
 
+template<EventQueueType QUEUE_TYPE>
+struct EventQueueTypeTag
+{
+  static const EventQueueType value = QUEUE_TYPE;
+};
+
+typedef boost::mpl::vector<EventQueueTypeTag<EventQueueType::ORDERED_SET>,
+                           EventQueueTypeTag<EventQueueType::BINARY_HEAP>> EventQueueTypes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ExecutionOrder, QueueType, EventQueueTypes)
+{
+  Scheduler sched(io, QueueType::value);
+
+  // events expire in the order of expiration time, ties are broken by the order of scheduling
+  std::vector<int> executed;
+  std::vector<EventId> eventIds;
+  for (int i = 0; i < 100; ++i) {
+    eventIds.push_back(sched.scheduleEvent(time::milliseconds(10 * ((i * 37) % 10)),
+                                           [&executed, i] { executed.push_back(i); }));
+  }
+  for (int i = 0; i < 100; i += 3) {
+    sched.cancelEvent(eventIds[i]);
+  }
+
+  advanceClocks(time::milliseconds(5), 30);
+
+  std::vector<int> expected;
+  for (int delay = 0; delay < 10; ++delay) {
+    for (int i = 0; i < 100; ++i) {
+      if ((i * 37) % 10 == delay && i % 3 != 0) {
+        expected.push_back(i);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(executed.begin(), executed.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(CancelMostEvents, QueueType, EventQueueTypes)
+{
+  Scheduler sched(io, QueueType::value);
+
+  auto token = make_shared<int>(0);
+  std::vector<int> executed;
+  std::vector<EventId> eventIds;
+  for (int i = 0; i < 100; ++i) {
+    eventIds.push_back(sched.scheduleEvent(time::milliseconds(10 + i),
+                                           [&executed, i, token] { executed.push_back(i); }));
+  }
+  // the first event is cancelled last
+  for (int i = 99; i >= 0; --i) {
+    if (i % 10 != 9) {
+      sched.cancelEvent(eventIds[i]);
+      BOOST_CHECK(!eventIds[i]);
+    }
+  }
+  // callbacks of cancelled events are released
+  BOOST_CHECK_EQUAL(token.use_count(), 11);
+
+  advanceClocks(time::milliseconds(5), 30);
+
+  std::vector<int> expected{9, 19, 29, 39, 49, 59, 69, 79, 89, 99};
+  BOOST_CHECK_EQUAL_COLLECTIONS(executed.begin(), executed.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(token.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseEventIdOnAnotherThread)
+{
+  Scheduler sched(io, EventQueueType::BINARY_HEAP);
+
+  // the last copy of an EventId may be dropped on another thread while the Scheduler
+  // allocates new events from the same pool
+  std::vector<EventId> eventIds;
+  for (int i = 0; i < 10000; ++i) {
+    eventIds.push_back(sched.scheduleEvent(time::milliseconds(1), [] {}));
+  }
+  sched.cancelAllEvents();
+
+  std::thread releaser([&eventIds] { eventIds.clear(); });
+  int nExecuted = 0;
+  for (int i = 0; i < 10000; ++i) {
+    sched.scheduleEvent(time::milliseconds(1), [&nExecuted] { ++nExecuted; });
+  }
+  releaser.join();
+
+  advanceClocks(time::milliseconds(1), 2);
+  BOOST_CHECK_EQUAL(nExecuted, 10000);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // General
 
 BOOST_AUTO_TEST_SUITE(EventId)
@@ -22,6 +22,7 @@
 #include "util/segment-fetcher.hpp"
 #include "security/validator-null.hpp"
 #include "lp/nack-header.hpp"
+#include "lp/tags.hpp"
 #include "data.hpp"
 #include "encoding/block.hpp"
 
@@ -429,6 +430,209 @@ BOOST_FIXTURE_TEST_CASE(ZeroComponentName, Fixture)
   BOOST_REQUIRE_EQUAL(nData, 1);
 }
 
+class WindowedFixture : public Fixture
+{
+public:
+  shared_ptr<Data>
+  makeNumberedSegment(uint64_t segment, optional<uint64_t> finalSegment = nullopt)
+  {
+    auto data = make_shared<Data>(Name("/hello/world/version0").appendSegment(segment));
+    const uint8_t content = static_cast<uint8_t>(segment);
+    data->setContent(&content, 1);
+    if (finalSegment) {
+      data->setFinalBlockId(name::Component::fromSegment(*finalSegment));
+    }
+    return signData(data);
+  }
+
+  void
+  start(const SegmentFetcher::Options& options, time::milliseconds lifetime = time::seconds(1000))
+  {
+    fetcher = SegmentFetcher::start(face, Interest("/hello/world", lifetime),
+                                    make_shared<ValidatorNull>(), options);
+    fetcher->onComplete.connect([this] (const ConstBufferPtr& data) {
+      ++nData;
+      output.assign(data->begin(), data->end());
+    });
+    fetcher->onError.connect([this] (uint32_t errorCode, const std::string&) {
+      onError(errorCode);
+    });
+    fetcher->onProgress.connect([this] (uint64_t nSegments, size_t) {
+      nDeliveredSegments = nSegments;
+    });
+    fetcher->afterSegmentTimedOut.connect([this] { ++nTimeouts; });
+    advanceClocks(time::milliseconds(10));
+  }
+
+  std::vector<uint64_t>
+  getSentSegments(size_t from) const
+  {
+    std::vector<uint64_t> segments;
+    for (size_t i = from; i < face.sentInterests.size(); ++i) {
+      segments.push_back(face.sentInterests[i].getName().get(-1).toSegment());
+    }
+    return segments;
+  }
+
+public:
+  shared_ptr<SegmentFetcher> fetcher;
+  std::vector<uint8_t> output;
+  uint64_t nDeliveredSegments = 0;
+  size_t nTimeouts = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE(WindowedReorder, WindowedFixture)
+{
+  SegmentFetcher::Options options;
+  options.useConstantWindow = true;
+  options.initialWindow = 4;
+  start(options);
+
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests[0].getName(), "/hello/world");
+  BOOST_CHECK_EQUAL(face.sentInterests[0].getChildSelector(), 1);
+
+  face.receive(*makeNumberedSegment(0));
+  advanceClocks(time::milliseconds(10));
+  std::vector<uint64_t> expected{1, 2, 3, 4};
+  std::vector<uint64_t> sent = getSentSegments(1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(nDeliveredSegments, 1);
+
+  face.receive(*makeNumberedSegment(3));
+  face.receive(*makeNumberedSegment(2));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nDeliveredSegments, 1);
+  expected = {5, 6};
+  sent = getSentSegments(5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+
+  face.receive(*makeNumberedSegment(1));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nDeliveredSegments, 4);
+  BOOST_CHECK_EQUAL(nData, 0);
+
+  face.receive(*makeNumberedSegment(4, 4));
+  advanceClocks(time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_REQUIRE_EQUAL(nData, 1);
+  std::vector<uint8_t> expectedOutput{0, 1, 2, 3, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(output.begin(), output.end(),
+                                expectedOutput.begin(), expectedOutput.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(WindowedRetransmitOnTimeout, WindowedFixture)
+{
+  SegmentFetcher::Options options;
+  options.useConstantWindow = true;
+  options.initialWindow = 2;
+  start(options, time::milliseconds(100));
+
+  face.receive(*makeNumberedSegment(0));
+  advanceClocks(time::milliseconds(10));
+  face.receive(*makeNumberedSegment(2, 2));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 3);
+
+  advanceClocks(time::milliseconds(10), 10);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(face.sentInterests.back().getName().get(-1).toSegment(), 1);
+
+  face.receive(*makeNumberedSegment(1, 2));
+  advanceClocks(time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_REQUIRE_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(output.size(), 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(WindowedRetransmitLimit, WindowedFixture)
+{
+  SegmentFetcher::Options options;
+  options.maxRetransmissions = 2;
+  start(options, time::milliseconds(100));
+
+  advanceClocks(time::milliseconds(10), 40);
+  BOOST_CHECK_EQUAL(nTimeouts, 3);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(nErrors, 1);
+  BOOST_CHECK_EQUAL(lastError, static_cast<uint32_t>(SegmentFetcher::INTEREST_TIMEOUT));
+}
+
+BOOST_FIXTURE_TEST_CASE(WindowedCongestionMark, WindowedFixture)
+{
+  SegmentFetcher::Options options;
+  options.initialWindow = 4;
+  start(options);
+
+  face.receive(*makeNumberedSegment(0));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_CLOSE(fetcher->getWindowSize(), 4.25, 0.1);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+
+  auto marked = makeNumberedSegment(1);
+  marked->setTag(make_shared<lp::CongestionMarkTag>(1));
+  face.receive(*marked);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_CLOSE(fetcher->getWindowSize(), 2.125, 0.1);
+
+  // segments requested before the decrease do not shrink the window again
+  marked = makeNumberedSegment(2);
+  marked->setTag(make_shared<lp::CongestionMarkTag>(1));
+  face.receive(*marked);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_CLOSE(fetcher->getWindowSize(), 2.125, 0.1);
+
+  face.receive(*makeNumberedSegment(3));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_CLOSE(fetcher->getWindowSize(), 2.625, 0.1);
+
+  fetcher->stop();
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(WindowedCongestionNack, WindowedFixture)
+{
+  SegmentFetcher::Options options;
+  options.initialWindow = 4;
+  start(options);
+
+  face.receive(*makeNumberedSegment(0));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_CLOSE(fetcher->getWindowSize(), 4.25, 0.1);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 5);
+
+  // the window is cut as for a congestion mark, and segment 1 is not retransmitted at once
+  face.receive(makeNack(face.sentInterests[1], lp::NackReason::CONGESTION));
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_CLOSE(fetcher->getWindowSize(), 2.125, 0.1);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+
+  // after the backoff, the retransmission waits for room in the window
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+  face.receive(*makeNumberedSegment(2));
+  face.receive(*makeNumberedSegment(3));
+  advanceClocks(time::milliseconds(10));
+  // the retransmission goes before the next new segment
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 7);
+  BOOST_CHECK_EQUAL(face.sentInterests[5].getName().get(-1).toSegment(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests[6].getName().get(-1).toSegment(), 5);
+
+  face.receive(*makeNumberedSegment(1));
+  face.receive(*makeNumberedSegment(4, 4));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSegmentFetcher
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -150,6 +150,86 @@ BOOST_AUTO_TEST_CASE(Basic)
   }
 }
 
+BOOST_AUTO_TEST_CASE(StatementCache)
+{
+  Sqlite3Statement(db, "CREATE TABLE test (t1 int)").step();
+
+  Sqlite3StatementCache cache(db);
+  for (int i = 0; i < 3; ++i) {
+    Sqlite3Statement stmt(cache, "INSERT INTO test VALUES (?)");
+    stmt.bind(1, i);
+    BOOST_CHECK_EQUAL(stmt.step(), SQLITE_DONE);
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  {
+    // the same statement can be used twice at the same time
+    Sqlite3Statement stmt1(cache, "SELECT t1 FROM test WHERE t1>=? ORDER BY t1");
+    stmt1.bind(1, 1);
+    BOOST_CHECK_EQUAL(stmt1.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(stmt1.getInt(0), 1);
+
+    Sqlite3Statement stmt2(cache, "SELECT t1 FROM test WHERE t1>=? ORDER BY t1");
+    stmt2.bind(1, 0);
+    BOOST_CHECK_EQUAL(stmt2.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(stmt2.getInt(0), 0);
+
+    BOOST_CHECK_EQUAL(stmt1.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(stmt1.getInt(0), 2);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 3);
+
+  {
+    // a reused statement starts over without the previous bindings
+    Sqlite3Statement stmt(cache, "SELECT t1 FROM test WHERE t1>=? ORDER BY t1");
+    BOOST_CHECK_EQUAL(stmt.step(), SQLITE_DONE);
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+  }
+
+  BOOST_CHECK_THROW(Sqlite3Statement(cache, "SELECT bad"), std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(Transaction)
+{
+  Sqlite3Statement(db, "CREATE TABLE test (t1 int)").step();
+  auto count = [this] {
+    Sqlite3Statement stmt(db, "SELECT count(*) FROM test");
+    stmt.step();
+    return stmt.getInt(0);
+  };
+
+  {
+    Sqlite3Transaction transaction(db);
+    Sqlite3Statement(db, "INSERT INTO test VALUES (1)").step();
+    transaction.commit();
+  }
+  BOOST_CHECK_EQUAL(count(), 1);
+
+  {
+    Sqlite3Transaction transaction(db);
+    Sqlite3Statement(db, "INSERT INTO test VALUES (2)").step();
+  }
+  BOOST_CHECK_EQUAL(count(), 1);
+
+  {
+    Sqlite3Transaction outer(db);
+    Sqlite3Statement(db, "INSERT INTO test VALUES (3)").step();
+    {
+      Sqlite3Transaction inner(db);
+      Sqlite3Statement(db, "INSERT INTO test VALUES (4)").step();
+    }
+    BOOST_CHECK_EQUAL(count(), 2);
+    {
+      Sqlite3Transaction inner(db);
+      Sqlite3Statement(db, "INSERT INTO test VALUES (5)").step();
+      inner.commit();
+    }
+    BOOST_CHECK_EQUAL(count(), 3);
+  }
+  BOOST_CHECK_EQUAL(count(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSqlite3Statement
 BOOST_AUTO_TEST_SUITE_END() // Util
 
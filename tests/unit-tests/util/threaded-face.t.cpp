@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/threaded-face.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "identity-management-fixture.hpp"
+#include "../make-interest-data.hpp"
+
+#include <future>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class ThreadedFaceFixture : public IdentityManagementV1Fixture
+{
+public:
+  ThreadedFace::FaceCreator
+  makeDummyFace()
+  {
+    return [this] (boost::asio::io_service& io) {
+      auto face = make_unique<DummyClientFace>(io, m_keyChain, DummyClientFace::Options{false, false});
+      dummyFace = face.get();
+      return unique_ptr<Face>(std::move(face));
+    };
+  }
+
+  /** \brief run \p f on the I/O thread, and wait until it returns
+   *
+   *  \p f runs after the commands queued so far, and after the handlers that Face has posted
+   *  for them, because it is posted twice.
+   */
+  void
+  runOnIoThread(ThreadedFace& face, const function<void()>& f)
+  {
+    auto done = make_shared<std::promise<void>>();
+    boost::asio::io_service& io = face.getFace().getIoService();
+    io.post([&io, f, done] {
+      io.post([f, done] {
+        f();
+        done->set_value();
+      });
+    });
+    done->get_future().wait();
+  }
+
+public:
+  DummyClientFace* dummyFace = nullptr;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestThreadedFace, ThreadedFaceFixture)
+
+BOOST_AUTO_TEST_CASE(ConcurrentPut)
+{
+  const size_t nThreads = 4;
+  const size_t nPacketsPerThread = 1000;
+  std::vector<Name> sentNames;
+  {
+    ThreadedFace face(makeDummyFace());
+    // signal handlers run on the I/O thread
+    dummyFace->onSendData.connect([&] (const Data& data) { sentNames.push_back(data.getName()); });
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < nThreads; ++i) {
+      producers.emplace_back([&face, i, nPacketsPerThread] {
+        for (size_t j = 0; j < nPacketsPerThread; ++j) {
+          face.put(*makeData(Name("/producer").appendNumber(i).appendSequenceNumber(j)));
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+  } // destructor executes remaining commands and joins the I/O thread
+
+  BOOST_REQUIRE_EQUAL(sentNames.size(), nThreads * nPacketsPerThread);
+
+  // packets from the same producer are sent in order
+  std::vector<uint64_t> nextSeqNo(nThreads, 0);
+  for (const Name& name : sentNames) {
+    size_t producer = static_cast<size_t>(name.at(1).toNumber());
+    BOOST_CHECK_EQUAL(name.at(2).toSequenceNumber(), nextSeqNo.at(producer)++);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Executor)
+{
+  std::vector<std::string> events;
+  std::promise<void> dataArrived;
+  size_t nExecuted = 0;
+  {
+    ThreadedFace face(makeDummyFace(), [&] (const function<void()>& callback) {
+      ++nExecuted; // executor is invoked on the I/O thread in this test
+      callback();
+    });
+    dummyFace->onSendInterest.connect([this] (const Interest& interest) {
+      dummyFace->getIoService().post([this, interest] {
+        dummyFace->receive(*makeData(interest.getName()));
+      });
+    });
+
+    face.setInterestFilter("/B", [&] (const InterestFilter&, const Interest& interest) {
+      events.push_back("interest " + interest.getName().toUri());
+    });
+    face.expressInterest(Interest("/A"),
+                         [&] (const Interest&, const Data& data) {
+                           events.push_back("data " + data.getName().toUri());
+                           dataArrived.set_value();
+                         },
+                         nullptr, nullptr);
+    face.put(*makeData("/C"));
+
+    dataArrived.get_future().wait();
+  }
+
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  BOOST_CHECK_EQUAL(events.front(), "data /A");
+  BOOST_CHECK_EQUAL(nExecuted, 1);
+}
+
+BOOST_AUTO_TEST_CASE(RemovePendingInterest)
+{
+  std::vector<std::string> events;
+  std::promise<void> dataArrived;
+  size_t nPendingInterests = 0;
+  {
+    ThreadedFace face(makeDummyFace());
+    // Data for /A arrives; /B is never answered
+    dummyFace->onSendInterest.connect([this] (const Interest& interest) {
+      if (interest.getName() == "/A") {
+        dummyFace->getIoService().post([this, interest] {
+          dummyFace->receive(*makeData(interest.getName()));
+        });
+      }
+    });
+
+    ThreadedFace::PendingInterestHandle a =
+      face.expressInterest(Interest("/A"),
+                           [&] (const Interest&, const Data&) {
+                             events.push_back("data /A");
+                             dataArrived.set_value();
+                           },
+                           nullptr, nullptr);
+    ThreadedFace::PendingInterestHandle b =
+      face.expressInterest(Interest("/B"),
+                           [&] (const Interest&, const Data&) { events.push_back("data /B"); },
+                           nullptr,
+                           [&] (const Interest&) { events.push_back("timeout /B"); });
+    BOOST_CHECK_NE(a, 0);
+    BOOST_CHECK_NE(a, b);
+
+    dataArrived.get_future().wait();
+    face.removePendingInterest(b);
+    face.removePendingInterest(a); // no effect, as /A has been satisfied
+    runOnIoThread(face, [&] { nPendingInterests = dummyFace->getNPendingInterests(); });
+  }
+
+  BOOST_CHECK_EQUAL(nPendingInterests, 0);
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  BOOST_CHECK_EQUAL(events.front(), "data /A");
+}
+
+BOOST_AUTO_TEST_CASE(UnsetInterestFilter)
+{
+  std::vector<std::string> events;
+  std::promise<void> interestArrived;
+  {
+    ThreadedFace face(makeDummyFace());
+    // Face performs each operation in a handler posted by the command, so an Interest is
+    // delivered after the preceding commands have taken effect if its delivery is posted twice
+    auto receiveLater = [&face, this] (const Name& name) {
+      face.getFace().getIoService().post([&face, this, name] {
+        face.getFace().getIoService().post([this, name] { dummyFace->receive(Interest(name)); });
+      });
+    };
+
+    ThreadedFace::InterestFilterHandle handle =
+      face.setInterestFilter("/A", [&] (const InterestFilter&, const Interest& interest) {
+        events.push_back(interest.getName().toUri());
+        if (events.size() == 1) {
+          interestArrived.set_value();
+        }
+      });
+    receiveLater("/A/1");
+    interestArrived.get_future().wait();
+
+    face.unsetInterestFilter(handle);
+    receiveLater("/A/2");
+    // runs after /A/2 has been delivered
+    runOnIoThread(face, [] {});
+  }
+
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  BOOST_CHECK_EQUAL(events.front(), "/A/1");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestThreadedFace
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn